@@ -0,0 +1,77 @@
+/*
+ * File:   DsscBroadcastPlanner.hh
+ *
+ * Grouping of modules with identical register content for a broadcast
+ * programming of their JTAG engines.
+ */
+
+#ifndef DSSCBROADCASTPLANNER_HH
+#define DSSCBROADCASTPLANNER_HH
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace karabo {
+
+    /**
+     * Modules (IOBs) with identical content are programmed in one pass with
+     * the JTAG engines of all of them enabled, modules with differing
+     * content one after another. Groups keep the order of the modules, the
+     * first module of a group is the one addressed while broadcasting.
+     */
+    class BroadcastPlanner {
+
+    public:
+
+        BroadcastPlanner() : m_modulesProgrammed(0), m_passes(0) {
+        }
+
+        template <class Content>
+        static std::vector<std::vector<int>> groups(const std::map<int, Content> & content) {
+            std::vector<std::vector<int>> res;
+            std::vector<const Content *> groupContent;
+            for (const auto & entry : content) {
+                size_t group = 0;
+                while (group < res.size() && !(*groupContent[group] == entry.second)) group++;
+                if (group == res.size()) {
+                    res.emplace_back();
+                    groupContent.push_back(&entry.second);
+                }
+                res[group].push_back(entry.first);
+            }
+            return res;
+        }
+
+        // Bit n-1 enables the JTAG engine of module n
+        static uint32_t engineMask(const std::vector<int> & modules) {
+            uint32_t mask = 0;
+            for (const int module : modules) {
+                if (module > 0 && module <= 32) mask |= 1u << (module - 1);
+            }
+            return mask;
+        }
+
+        // Modules programmed by a number of programming passes
+        void addProgramming(unsigned long long modules, unsigned long long passes) {
+            m_modulesProgrammed += modules;
+            m_passes += passes;
+        }
+
+        unsigned long long modulesProgrammed() const {
+            return m_modulesProgrammed;
+        }
+
+        unsigned long long passes() const {
+            return m_passes;
+        }
+
+    private:
+
+        std::atomic<unsigned long long> m_modulesProgrammed;
+        std::atomic<unsigned long long> m_passes;
+    };
+}
+
+#endif
@@ -0,0 +1,101 @@
+/*
+ * File:   DsscHardwareFingerprint.hh
+ *
+ * Compact description of the PPT hardware state used for warm reconnects.
+ */
+
+#ifndef DSSCHARDWAREFINGERPRINT_HH
+#define DSSCHARDWAREFINGERPRINT_HH
+
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace karabo {
+
+    /**
+     * Named values describing the state of a PPT (serial number, build
+     * stamps, PLL status, key EPC registers, active IOBs). Two fingerprints
+     * taken before and after a software-only restart are equal as long as
+     * the hardware kept running, in that case reset and PLL programming can
+     * be skipped on reconnect.
+     *
+     * Persisted as one "key=value" line per field.
+     */
+    class HardwareFingerprint {
+
+    public:
+
+        void set(const std::string & key, const std::string & value) {
+            m_fields[key] = value;
+        }
+
+        std::string get(const std::string & key) const {
+            auto it = m_fields.find(key);
+            return (it == m_fields.end()) ? std::string() : it->second;
+        }
+
+        bool empty() const {
+            return m_fields.empty();
+        }
+
+        // Keys with different values in the two fingerprints, including keys missing in one of them
+        std::vector<std::string> differences(const HardwareFingerprint & other) const {
+            std::vector<std::string> res;
+            for (const auto & field : m_fields) {
+                auto it = other.m_fields.find(field.first);
+                if (it == other.m_fields.end() || it->second != field.second) {
+                    res.push_back(field.first);
+                }
+            }
+            for (const auto & field : other.m_fields) {
+                if (m_fields.find(field.first) == m_fields.end()) {
+                    res.push_back(field.first);
+                }
+            }
+            return res;
+        }
+
+        std::string toString() const {
+            std::stringstream ss;
+            for (const auto & field : m_fields) {
+                ss << field.first << "=" << field.second << "\n";
+            }
+            return ss.str();
+        }
+
+        static HardwareFingerprint fromString(const std::string & str) {
+            HardwareFingerprint fingerprint;
+            std::stringstream ss(str);
+            std::string line;
+            while (std::getline(ss, line)) {
+                const size_t pos = line.find('=');
+                if (pos == std::string::npos) continue;
+                fingerprint.set(line.substr(0, pos), line.substr(pos + 1));
+            }
+            return fingerprint;
+        }
+
+        bool save(const std::string & fileName) const {
+            std::ofstream out(fileName, std::ios::trunc);
+            out << toString();
+            return out.good();
+        }
+
+        // Returns an empty fingerprint if the file does not exist
+        static HardwareFingerprint load(const std::string & fileName) {
+            std::ifstream in(fileName);
+            std::stringstream ss;
+            ss << in.rdbuf();
+            return fromString(ss.str());
+        }
+
+    private:
+
+        std::map<std::string, std::string> m_fields;
+    };
+}
+
+#endif
@@ -0,0 +1,163 @@
+/*
+ * File:   DsscHotReconfig.hh
+ *
+ * Classification of register changes which can be written while running.
+ */
+
+#ifndef DSSCHOTRECONFIG_HH
+#define DSSCHOTRECONFIG_HH
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace karabo {
+
+    /**
+     * Decides which register changes are safe to write between two trains
+     * without leaving continuous mode, all others are written immediately.
+     *
+     * Registers are named "moduleSet/signal" per register type (EPC, IOB,
+     * JTAG, SEQ). A safe pattern matches a whole module set ("CLR_duty"), a
+     * single signal ("Global FCSR 0/MonBusSwitch") or, with a trailing '*',
+     * every name starting with the prefix ("CLR_*").
+     */
+    class HotReconfigPolicy {
+
+    public:
+
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr std::chrono::milliseconds DEFAULT_TRAIN_PERIOD{100}; // 10 Hz, if not measured yet
+
+        enum Class {
+            SAFE, UNSAFE
+        };
+
+        struct Change {
+
+            std::string regType;
+            std::string moduleSet;
+            std::string signal; // empty if the whole module set changes
+        };
+
+        static const std::map<std::string, std::string> & defaultSafePatterns() {
+            static const std::map<std::string, std::string> defaults{
+                {"EPC", "Data_Monitor_Select,Det_Specific_Data_Register,Multi_purpose_Register/ddr throttle divider"},
+                {"IOB", "CLR_*,FET_gate_*,FET_source_*,IProg_clr_*,PRB_GDPS_delay"},
+                {"JTAG", "Global Control Register/Pixel Injection*,Global Control Register/VDAC*,"
+                    "Global Control Register/Monitor*,Global FCSR 0/MonBusSwitch,Global FCSR 0/GndInjSwitch"},
+                {"SEQ", "start_wait_time,start_wait_offs,gdps_on_time,fet_on_time,clr_on_time,clr_cycle,clrDuty,"
+                    "iprog_clr_duty,iprog_clr_offset,iprog_clr_en"}
+            };
+            return defaults;
+        }
+
+        HotReconfigPolicy() : m_numHotWrites(0), m_numUnsafeWrites(0), m_numOverruns(0) {
+            for (const auto & entry : defaultSafePatterns()) {
+                setSafePatterns(entry.first, entry.second);
+            }
+        }
+
+        // Comma separated safe patterns of one register type
+        void setSafePatterns(const std::string & regType, const std::string & patterns) {
+            std::vector<std::string> parsed;
+            std::istringstream in(patterns);
+            std::string pattern;
+            while (std::getline(in, pattern, ',')) {
+                const size_t first = pattern.find_first_not_of(' ');
+                if (first == std::string::npos) continue;
+                parsed.push_back(pattern.substr(first, pattern.find_last_not_of(' ') - first + 1));
+            }
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_safePatterns[regType] = parsed;
+        }
+
+        Class classify(const std::string & regType, const std::string & moduleSet, const std::string & signal = "") const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const auto it = m_safePatterns.find(regType);
+            if (it == m_safePatterns.end()) return UNSAFE;
+            const std::string name = signal.empty() ? moduleSet : moduleSet + "/" + signal;
+            for (const auto & pattern : it->second) {
+                if (matches(pattern, moduleSet) || (!signal.empty() && matches(pattern, name))) return SAFE;
+            }
+            return UNSAFE;
+        }
+
+        // Safe only if every change is safe
+        Class classifyAll(const std::vector<Change> & changes) const {
+            for (const auto & change : changes) {
+                if (classify(change.regType, change.moduleSet, change.signal) == UNSAFE) return UNSAFE;
+            }
+            return SAFE;
+        }
+
+        // First train boundary after now, from the arrival of a past train and the train period
+        static Clock::time_point nextTrainBoundary(Clock::time_point lastArrival, Clock::duration period, Clock::time_point now) {
+            if (period <= Clock::duration::zero() || lastArrival > now) return lastArrival;
+            const auto numTrains = (now - lastArrival) / period + 1;
+            return lastArrival + numTrains * period;
+        }
+
+        /**
+         * Start of a write taking writeTime in the gaps starting at gapStart
+         * every period and lasting until delay before the next gap start (the
+         * next train). Now if the write fits into the current gap, otherwise
+         * the start of the next gap.
+         */
+        static Clock::time_point nextWriteStart(Clock::time_point gapStart, Clock::duration delay, Clock::duration period,
+                                                Clock::duration writeTime, Clock::time_point now) {
+            if (now < gapStart || period <= Clock::duration::zero()) return std::max(now, gapStart);
+            const auto currentStart = gapStart + (now - gapStart) / period * period;
+            if (now + writeTime <= currentStart - delay + period) return now;
+            return currentStart + period;
+        }
+
+        // Counts the changes written while running, in the train gaps or immediately
+        void countHotWrite() {
+            m_numHotWrites++;
+        }
+
+        void countUnsafeWrite() {
+            m_numUnsafeWrites++;
+        }
+
+        // A hot write did not finish before the next train
+        void countOverrun() {
+            m_numOverruns++;
+        }
+
+        unsigned long long numHotWrites() const {
+            return m_numHotWrites;
+        }
+
+        unsigned long long numUnsafeWrites() const {
+            return m_numUnsafeWrites;
+        }
+
+        unsigned long long numOverruns() const {
+            return m_numOverruns;
+        }
+
+    private:
+
+        static bool matches(const std::string & pattern, const std::string & name) {
+            if (!pattern.empty() && pattern.back() == '*') {
+                return name.compare(0, pattern.size() - 1, pattern, 0, pattern.size() - 1) == 0;
+            }
+            return pattern == name;
+        }
+
+        mutable std::mutex m_mutex;
+        std::map<std::string, std::vector<std::string>> m_safePatterns;
+        std::atomic<unsigned long long> m_numHotWrites;
+        std::atomic<unsigned long long> m_numUnsafeWrites;
+        std::atomic<unsigned long long> m_numOverruns;
+    };
+}
+
+#endif
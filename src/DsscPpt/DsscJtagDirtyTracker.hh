@@ -0,0 +1,87 @@
+/*
+ * File:   DsscJtagDirtyTracker.hh
+ *
+ * Values last programmed into the JTAG module sets of every module.
+ */
+
+#ifndef DSSCJTAGDIRTYTRACKER_HH
+#define DSSCJTAGDIRTYTRACKER_HH
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace karabo {
+
+    /**
+     * Remembers per module (IOB) and JTAG module set the signal values last
+     * programmed successfully. A module set is dirty if its current values
+     * differ or nothing is known about it, e.g. after an ASIC reset or a
+     * programming done outside of the tracker, which must invalidate the
+     * module.
+     */
+    class JtagDirtyTracker {
+
+    public:
+
+        using Values = std::vector<uint32_t>;
+
+        bool isDirty(int module, const std::string & moduleSet, const Values & values) const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const auto moduleIt = m_programmed.find(module);
+            if (moduleIt == m_programmed.end()) return true;
+            const auto setIt = moduleIt->second.find(moduleSet);
+            return setIt == moduleIt->second.end() || setIt->second != values;
+        }
+
+        void programmed(int module, const std::string & moduleSet, const Values & values) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_programmed[module][moduleSet] = values;
+        }
+
+        // The module set was programmed with unknown values or failed
+        void invalidate(int module, const std::string & moduleSet) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const auto moduleIt = m_programmed.find(module);
+            if (moduleIt != m_programmed.end()) moduleIt->second.erase(moduleSet);
+        }
+
+        void invalidate(int module) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_programmed.erase(module);
+        }
+
+        void invalidateAll() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_programmed.clear();
+        }
+
+        // Bits of all module sets requested by one programming and the bits of the dirty ones shifted
+        void addProgramming(uint64_t bitsRequested, uint64_t bitsShifted) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bitsRequested += bitsRequested;
+            m_bitsShifted += bitsShifted;
+        }
+
+        uint64_t bitsRequested() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_bitsRequested;
+        }
+
+        uint64_t bitsShifted() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_bitsShifted;
+        }
+
+    private:
+
+        mutable std::mutex m_mutex;
+        std::map<int, std::map<std::string, Values>> m_programmed;
+        uint64_t m_bitsRequested = 0;
+        uint64_t m_bitsShifted = 0;
+    };
+}
+
+#endif
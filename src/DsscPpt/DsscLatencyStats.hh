@@ -0,0 +1,245 @@
+/*
+ * File:   DsscLatencyStats.hh
+ *
+ * Latency histograms used to instrument access to the PPT.
+ */
+
+#ifndef DSSCLATENCYSTATS_HH
+#define DSSCLATENCYSTATS_HH
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace karabo {
+
+    /**
+     * Histogram with logarithmic bins of durations given in milliseconds.
+     * Bin i holds samples in [2^(i-1), 2^i) microseconds, bin 0 everything
+     * below one microsecond, the last bin everything above ~35 minutes.
+     */
+    class LatencyHistogram {
+
+    public:
+
+        static constexpr size_t NUM_BINS = 32;
+
+        LatencyHistogram() {
+            clear();
+        }
+
+        void add(double ms) {
+            const double us = std::max(0.0, ms * 1000.0);
+            size_t bin = (us < 1.0) ? 0 : static_cast<size_t> (std::floor(std::log2(us))) + 1;
+            m_bins[std::min(bin, NUM_BINS - 1)]++;
+            m_count++;
+            m_sum += ms;
+            m_max = std::max(m_max, ms);
+        }
+
+        void clear() {
+            m_bins.fill(0);
+            m_count = 0;
+            m_sum = 0.0;
+            m_max = 0.0;
+        }
+
+        uint64_t count() const {
+            return m_count;
+        }
+
+        double max() const {
+            return m_max;
+        }
+
+        double mean() const {
+            return m_count ? m_sum / m_count : 0.0;
+        }
+
+        /**
+         * Percentile in ms, p in [0, 1]. Interpolates linearly inside the
+         * bin the percentile falls into and never exceeds the maximum.
+         */
+        double percentile(double p) const {
+            if (m_count == 0) return 0.0;
+            const double target = std::clamp(p, 0.0, 1.0) * m_count;
+            double cumulated = 0.0;
+            for (size_t bin = 0; bin < NUM_BINS; ++bin) {
+                if (m_bins[bin] == 0) continue;
+                if (cumulated + m_bins[bin] >= target) {
+                    const double lowUs = (bin == 0) ? 0.0 : std::ldexp(1.0, bin - 1);
+                    const double highUs = std::ldexp(1.0, bin);
+                    const double fraction = (target - cumulated) / m_bins[bin];
+                    return std::min(m_max, (lowUs + fraction * (highUs - lowUs)) / 1000.0);
+                }
+                cumulated += m_bins[bin];
+            }
+            return m_max;
+        }
+
+    private:
+
+        std::array<uint64_t, NUM_BINS> m_bins;
+        uint64_t m_count;
+        double m_sum;
+        double m_max;
+    };
+
+    /**
+     * Thread safe collection of latency histograms keyed by an origin name,
+     * e.g. the calling function.
+     */
+    class LatencyStatsTable {
+
+    public:
+
+        struct Summary {
+
+            std::string name;
+            uint64_t count;
+            double p50;
+            double p95;
+            double max;
+        };
+
+        void add(const std::string & name, double ms) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_histograms[name].add(ms);
+        }
+
+        void clear() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_histograms.clear();
+        }
+
+        std::vector<Summary> summary() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::vector<Summary> res;
+            res.reserve(m_histograms.size());
+            for (const auto & entry : m_histograms) {
+                const auto & hist = entry.second;
+                res.push_back({entry.first, hist.count(), hist.percentile(0.5), hist.percentile(0.95), hist.max()});
+            }
+            return res;
+        }
+
+    private:
+
+        mutable std::mutex m_mutex;
+        std::map<std::string, LatencyHistogram> m_histograms;
+    };
+
+    /**
+     * Keeps the last WINDOW samples of one operation for rolling percentiles
+     * plus the total number of calls.
+     */
+    class RollingLatency {
+
+    public:
+
+        static constexpr size_t WINDOW = 256;
+
+        RollingLatency() : m_next(0), m_count(0) {
+        }
+
+        void add(double ms) {
+            m_samples[m_next] = ms;
+            m_next = (m_next + 1) % WINDOW;
+            m_count++;
+        }
+
+        uint64_t count() const {
+            return m_count;
+        }
+
+        // p in [0, 1], over the samples in the window
+        std::vector<double> percentiles(const std::vector<double> & ps) const {
+            const size_t num = std::min<uint64_t>(m_count, WINDOW);
+            std::vector<double> sorted(m_samples.begin(), m_samples.begin() + num);
+            std::sort(sorted.begin(), sorted.end());
+            std::vector<double> res;
+            for (double p : ps) {
+                if (num == 0) {
+                    res.push_back(0.0);
+                } else {
+                    size_t idx = static_cast<size_t> (std::ceil(std::clamp(p, 0.0, 1.0) * num));
+                    res.push_back(sorted[std::min(num - 1, idx ? idx - 1 : 0)]);
+                }
+            }
+            return res;
+        }
+
+    private:
+
+        std::array<double, WINDOW> m_samples;
+        size_t m_next;
+        uint64_t m_count;
+    };
+
+    /**
+     * Thread safe rolling latencies keyed by operation name.
+     */
+    class RollingStatsTable {
+
+    public:
+
+        void add(const char * name, double ms) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_latencies[name].add(ms);
+        }
+
+        void clear() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_latencies.clear();
+        }
+
+        std::vector<LatencyStatsTable::Summary> summary() const {
+            std::vector<std::pair<std::string, RollingLatency>> copy;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                copy.assign(m_latencies.begin(), m_latencies.end());
+            }
+            std::vector<LatencyStatsTable::Summary> res;
+            for (const auto & entry : copy) {
+                const auto p = entry.second.percentiles({0.5, 0.95, 1.0});
+                res.push_back({entry.first, entry.second.count(), p[0], p[1], p[2]});
+            }
+            return res;
+        }
+
+    private:
+
+        mutable std::mutex m_mutex;
+        std::map<std::string, RollingLatency> m_latencies;
+    };
+
+    /**
+     * Records the lifetime of the object under the given operation name.
+     */
+    class ScopedLatencyTimer {
+
+    public:
+
+        ScopedLatencyTimer(RollingStatsTable & table, const char * name)
+            : m_table(table), m_name(name), m_start(std::chrono::steady_clock::now()) {
+        }
+
+        ~ScopedLatencyTimer() {
+            m_table.add(m_name, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count());
+        }
+
+    private:
+
+        RollingStatsTable & m_table;
+        const char * m_name;
+        std::chrono::steady_clock::time_point m_start;
+    };
+}
+
+#endif
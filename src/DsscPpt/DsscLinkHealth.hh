@@ -0,0 +1,146 @@
+/*
+ * File:   DsscLinkHealth.hh
+ *
+ * Failure statistics of the ASIC readout links of the IOBs.
+ */
+
+#ifndef DSSCLINKHEALTH_HH
+#define DSSCLINKHEALTH_HH
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace karabo {
+
+    /**
+     * Collects samples of the ASIC channel readout failure bitmask of the
+     * IOBs 1 to 4. For every ASIC the number of failed samples is counted
+     * and the failure rate, the fraction of failed samples, is computed over
+     * sliding windows of 1, 10 and 60 minutes.
+     */
+    class LinkHealth {
+
+    public:
+
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t NUM_IOBS = 4;
+        static constexpr size_t NUM_ASICS = 16;
+        static constexpr std::array<std::chrono::seconds, 3> WINDOWS{
+            {std::chrono::seconds(60), std::chrono::seconds(600), std::chrono::seconds(3600)}
+        };
+        // Window used by summary()
+        static constexpr size_t SUMMARY_WINDOW = 1;
+
+        void addSample(Clock::time_point time, int iob, uint16_t failures) {
+            if (!valid(iob)) return;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Iob & state = m_iobs[iob - 1];
+            state.samples.emplace_back(time, failures);
+            while (time - state.samples.front().first > WINDOWS.back()) {
+                state.samples.pop_front();
+            }
+            for (size_t asic = 0; asic < NUM_ASICS; ++asic) {
+                if (failures & (1 << asic)) state.counts[asic]++;
+            }
+            state.numSamples++;
+        }
+
+        void setAuroraReady(int iob, bool ready) {
+            if (!valid(iob)) return;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_iobs[iob - 1].auroraReady = ready ? 1 : 0;
+        }
+
+        void reset() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_iobs = {};
+        }
+
+        uint64_t numSamples(int iob) const {
+            if (!valid(iob)) return 0;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_iobs[iob - 1].numSamples;
+        }
+
+        // Failed samples per ASIC since the last reset
+        std::vector<unsigned long long> failureCounts(int iob) const {
+            if (!valid(iob)) return {};
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const auto & counts = m_iobs[iob - 1].counts;
+            return std::vector<unsigned long long>(counts.begin(), counts.end());
+        }
+
+        // Fraction of failed samples per ASIC in the window ending at now
+        std::vector<double> failureRates(int iob, std::chrono::seconds window, Clock::time_point now) const {
+            if (!valid(iob)) return {};
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return rates(m_iobs[iob - 1], window, now);
+        }
+
+        // Failing ASICs and unlocked aurora links, "all links ok" if none
+        std::string summary(Clock::time_point now) const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::ostringstream res;
+            res << std::fixed << std::setprecision(1);
+            for (size_t i = 0; i < NUM_IOBS; ++i) {
+                const auto iobRates = rates(m_iobs[i], WINDOWS[SUMMARY_WINDOW], now);
+                std::ostringstream iob;
+                iob << std::fixed << std::setprecision(1);
+                for (size_t asic = 0; asic < NUM_ASICS; ++asic) {
+                    if (iobRates[asic] > 0) {
+                        iob << (iob.tellp() > 0 ? ", " : "") << "ASIC " << asic << " " << 100 * iobRates[asic] << "%";
+                    }
+                }
+                if (m_iobs[i].auroraReady == 0) iob << (iob.tellp() > 0 ? ", " : "") << "aurora not ready";
+                if (iob.tellp() > 0) {
+                    res << (res.tellp() > 0 ? "; " : "") << "IOB" << i + 1 << ": " << iob.str();
+                }
+            }
+            return res.tellp() > 0 ? res.str() : "all links ok";
+        }
+
+    private:
+
+        struct Iob {
+
+            std::deque<std::pair<Clock::time_point, uint16_t>> samples;
+            std::array<uint64_t, NUM_ASICS> counts{};
+            uint64_t numSamples = 0;
+            int auroraReady = -1; // unknown until sampled
+        };
+
+        static bool valid(int iob) {
+            return iob >= 1 && iob <= static_cast<int> (NUM_IOBS);
+        }
+
+        static std::vector<double> rates(const Iob & state, std::chrono::seconds window, Clock::time_point now) {
+            std::vector<double> res(NUM_ASICS, 0.0);
+            size_t numSamples = 0;
+            for (const auto & sample : state.samples) {
+                if (now - sample.first > window) continue;
+                numSamples++;
+                for (size_t asic = 0; asic < NUM_ASICS; ++asic) {
+                    if (sample.second & (1 << asic)) res[asic] += 1;
+                }
+            }
+            if (numSamples > 0) {
+                for (auto & rate : res) rate /= numSamples;
+            }
+            return res;
+        }
+
+        mutable std::mutex m_mutex;
+        std::array<Iob, NUM_IOBS> m_iobs;
+    };
+}
+
+#endif
@@ -0,0 +1,187 @@
+/*
+ * File:   DsscOperationProgress.hh
+ *
+ * Step-wise progress and cooperative cancellation of long PPT sequences.
+ */
+
+#ifndef DSSCOPERATIONPROGRESS_HH
+#define DSSCOPERATIONPROGRESS_HH
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace karabo {
+
+    /**
+     * Tracks the progress of one long running operation made of a known
+     * number of steps. An abort request is only honoured between steps:
+     * nextStep() returns false once abort() was called and the sequence is
+     * expected to return early.
+     *
+     * Operations may nest (e.g. initSystem programs the IOB FPGAs). A nested
+     * begin() keeps name and step count of the outer operation, steps of the
+     * nested operation only update the step name and check for an abort.
+     */
+    class OperationProgress {
+
+    public:
+
+        enum class Result {
+            IDLE, RUNNING, FINISHED, ABORTED
+        };
+
+        struct Snapshot {
+
+            std::string name;
+            std::string step;
+            double percent;
+            double elapsed; // seconds
+            double eta;     // seconds, negative if unknown
+            Result result;
+        };
+
+        OperationProgress() : m_depth(0), m_numSteps(0), m_doneSteps(0), m_result(Result::IDLE), m_abort(false) {
+        }
+
+        // Called after every change of the progress, e.g. to publish it
+        void setListener(const std::function<void()> & listener) {
+            m_listener = listener;
+        }
+
+        void begin(const std::string & name, unsigned int numSteps) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_depth++ > 0) return;
+                m_name = name;
+                m_step = "";
+                m_numSteps = numSteps;
+                m_doneSteps = 0;
+                m_start = std::chrono::steady_clock::now();
+                m_result = Result::RUNNING;
+                m_abort = false;
+            }
+            notify();
+        }
+
+        /**
+         * Marks the previous step as done and enters the next one.
+         * Returns false if the operation was aborted.
+         */
+        bool nextStep(const std::string & step) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_abort) {
+                    m_result = Result::ABORTED;
+                    return false;
+                }
+                if (m_depth <= 1 && !m_step.empty() && m_doneSteps < m_numSteps) {
+                    m_doneSteps++;
+                }
+                m_step = step;
+            }
+            notify();
+            return true;
+        }
+
+        bool isAborted() const {
+            return m_abort;
+        }
+
+        void end() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_depth == 0 || --m_depth > 0) return;
+                if (m_abort) {
+                    m_result = Result::ABORTED;
+                } else {
+                    m_doneSteps = m_numSteps;
+                    m_result = Result::FINISHED;
+                }
+                m_abort = false;
+            }
+            notify();
+        }
+
+        // Returns false if no operation is running
+        bool abort() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_depth == 0) return false;
+            m_abort = true;
+            return true;
+        }
+
+        Snapshot snapshot() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Snapshot snap{m_name, m_step, 0.0, 0.0, -1.0, m_result};
+            if (m_result == Result::IDLE) return snap;
+
+            snap.elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+            if (m_numSteps > 0) {
+                snap.percent = 100.0 * m_doneSteps / m_numSteps;
+            }
+            if (m_result == Result::RUNNING && m_doneSteps > 0) {
+                snap.eta = snap.elapsed / m_doneSteps * (m_numSteps - m_doneSteps);
+            } else if (m_result != Result::RUNNING) {
+                snap.eta = 0.0;
+            }
+            return snap;
+        }
+
+        static std::string toString(Result result) {
+            switch (result) {
+                case Result::RUNNING: return "RUNNING";
+                case Result::FINISHED: return "FINISHED";
+                case Result::ABORTED: return "ABORTED";
+                default: return "IDLE";
+            }
+        }
+
+    private:
+
+        void notify() {
+            if (m_listener) m_listener();
+        }
+
+        mutable std::mutex m_mutex;
+        std::function<void()> m_listener;
+        int m_depth;
+        std::string m_name;
+        std::string m_step;
+        unsigned int m_numSteps;
+        unsigned int m_doneSteps;
+        std::chrono::steady_clock::time_point m_start;
+        Result m_result;
+        std::atomic<bool> m_abort;
+    };
+
+    /**
+     * Runs an operation for the lifetime of the object, so that early returns
+     * (including aborts) always end it.
+     */
+    class ScopedOperation {
+
+    public:
+
+        ScopedOperation(OperationProgress & progress, const std::string & name, unsigned int numSteps)
+            : m_progress(progress) {
+            m_progress.begin(name, numSteps);
+        }
+
+        ~ScopedOperation() {
+            m_progress.end();
+        }
+
+        bool nextStep(const std::string & step) {
+            return m_progress.nextStep(step);
+        }
+
+    private:
+
+        OperationProgress & m_progress;
+    };
+}
+
+#endif
@@ -0,0 +1,176 @@
+/*
+ * File:   DsscPixelDeltaPlanner.hh
+ *
+ * Choice of the cheapest way to program the pixels changed since the last
+ * pixel register programming.
+ */
+
+#ifndef DSSCPIXELDELTAPLANNER_HH
+#define DSSCPIXELDELTAPLANNER_HH
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace karabo {
+
+    enum class PixelStrategy {
+        NONE, // nothing changed
+        FULL, // the whole control register stream
+        UNIFORM, // all pixels have the same value, broadcast to all
+        DIRECT // addressed writes of the changed pixels
+    };
+
+    inline std::string pixelStrategyName(PixelStrategy strategy) {
+        switch (strategy) {
+            case PixelStrategy::NONE: return "NONE";
+            case PixelStrategy::FULL: return "FULL";
+            case PixelStrategy::UNIFORM: return "UNIFORM";
+            case PixelStrategy::DIRECT: return "DIRECT";
+        }
+        return "";
+    }
+
+    struct PixelPlan {
+
+        PixelStrategy strategy;
+        std::vector<uint32_t> pixels; // changed pixels
+        uint64_t bits; // bits shifted by the strategy
+    };
+
+    /**
+     * Keeps the register content of every pixel as last programmed per
+     * module (IOB) and plans the next programming: a full stream of
+     * numPixels * bitsPerPixel bits, a broadcast of one pixel word if all
+     * pixels are equal, or an addressed write of every changed pixel
+     * costing bitsPerPixel plus the addressing overhead.
+     *
+     * The content is passed as signalValues[signal][pixel]. A fingerprint
+     * per pixel is only a fast pre-check, pixels with equal fingerprints
+     * are compared signal by signal before they are skipped.
+     */
+    class PixelDeltaPlanner {
+
+    public:
+
+        using SignalValues = std::vector<std::vector<uint32_t>>;
+
+        PixelDeltaPlanner() : m_bitsPerPixel(54), m_directOverheadBits(200) {
+        }
+
+        void setBitsPerPixel(uint32_t bits) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bitsPerPixel = bits;
+        }
+
+        // JTAG bits needed to address one pixel for a direct write
+        void setDirectOverheadBits(uint32_t bits) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_directOverheadBits = bits;
+        }
+
+        // Fingerprint per pixel from the values of every signal, signalValues[signal][pixel]
+        static std::vector<uint64_t> fingerprints(const SignalValues & signalValues) {
+            const size_t numPixels = signalValues.empty() ? 0 : signalValues.front().size();
+            std::vector<uint64_t> res(numPixels, 14695981039346656037ULL); // FNV-1a
+            for (const auto & values : signalValues) {
+                for (size_t px = 0; px < numPixels && px < values.size(); ++px) {
+                    uint64_t & hash = res[px];
+                    for (int byte = 0; byte < 4; ++byte) {
+                        hash ^= (values[px] >> (8 * byte)) & 0xFF;
+                        hash *= 1099511628211ULL;
+                    }
+                }
+            }
+            return res;
+        }
+
+        static size_t numPixels(const SignalValues & signalValues) {
+            return signalValues.empty() ? 0 : signalValues.front().size();
+        }
+
+        PixelPlan plan(int module, const SignalValues & signalValues) const {
+            const size_t numPx = numPixels(signalValues);
+            const auto pixels = fingerprints(signalValues);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const uint64_t fullBits = static_cast<uint64_t> (numPx) * m_bitsPerPixel;
+            const bool uniform = numPx > 0 && std::all_of(signalValues.begin(), signalValues.end(), [](const auto & values) {
+                return values.empty() || std::equal(values.begin() + 1, values.end(), values.begin());
+            });
+
+            PixelPlan res{PixelStrategy::FULL, {}, fullBits};
+            const auto it = m_programmed.find(module);
+            if (it == m_programmed.end() || !sameLayout(it->second.values, signalValues)) {
+                res.pixels.resize(numPx);
+                for (uint32_t px = 0; px < numPx; ++px) res.pixels[px] = px;
+            } else {
+                for (uint32_t px = 0; px < numPx; ++px) {
+                    if (pixels[px] != it->second.fingerprints[px] || !samePixel(it->second.values, signalValues, px)) {
+                        res.pixels.push_back(px);
+                    }
+                }
+                if (res.pixels.empty()) return {PixelStrategy::NONE, {}, 0};
+                const uint64_t directBits = res.pixels.size() * static_cast<uint64_t> (m_bitsPerPixel + m_directOverheadBits);
+                if (directBits < res.bits) {
+                    res.strategy = PixelStrategy::DIRECT;
+                    res.bits = directBits;
+                }
+            }
+            if (uniform && m_bitsPerPixel < res.bits) {
+                res.strategy = PixelStrategy::UNIFORM;
+                res.bits = m_bitsPerPixel;
+            }
+            return res;
+        }
+
+        void programmed(int module, const SignalValues & signalValues) {
+            Content content{fingerprints(signalValues), signalValues};
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_programmed[module] = std::move(content);
+        }
+
+        void invalidate(int module) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_programmed.erase(module);
+        }
+
+        void invalidateAll() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_programmed.clear();
+        }
+
+    private:
+
+        struct Content {
+
+            std::vector<uint64_t> fingerprints;
+            SignalValues values;
+        };
+
+        static bool sameLayout(const SignalValues & a, const SignalValues & b) {
+            if (a.size() != b.size()) return false;
+            for (size_t signal = 0; signal < a.size(); ++signal) {
+                if (a[signal].size() != b[signal].size() || b[signal].size() != b.front().size()) return false;
+            }
+            return true;
+        }
+
+        static bool samePixel(const SignalValues & a, const SignalValues & b, size_t px) {
+            for (size_t signal = 0; signal < a.size(); ++signal) {
+                if (a[signal][px] != b[signal][px]) return false;
+            }
+            return true;
+        }
+
+        mutable std::mutex m_mutex;
+        uint32_t m_bitsPerPixel;
+        uint32_t m_directOverheadBits;
+        std::map<int, Content> m_programmed;
+    };
+}
+
+#endif
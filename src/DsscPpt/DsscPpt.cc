@@ -7,11 +7,17 @@
  *
  * Copyright (c) 2010-2013 European XFEL GmbH Hamburg. All rights reserved.
  */
+#include <algorithm>
+#include <bit>
 #include <filesystem>
 #include <boost/assign/std/vector.hpp> // for 'operator+=()'
 #include <boost/functional/hash.hpp>
 #include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/join.hpp>
+#include <boost/algorithm/string/case_conv.hpp>
 #include <chrono>
+#include <iomanip>
+#include <tuple>
 
 #include "DsscPpt.hh"
 #include "DsscPptRegsInit.hh"
@@ -84,6 +90,50 @@ namespace karabo {
                 .expertAccess()
                 .commit();
 
+        BOOL_ELEMENT(expected).key("telemetryConnection")
+                .displayedName("Telemetry Connection")
+                .description("Open a second connection to the PPT used only for read-only telemetry "
+                             "(temperature, output rate, train id), so that monitoring keeps updating "
+                             "while the main connection is programming. Falls back to the main connection "
+                             "if the second one can not be opened")
+                .assignmentOptional().defaultValue(false).reconfigurable()
+                .allowedStates(State::UNKNOWN)
+                .expertAccess()
+                .commit();
+
+        BOOL_ELEMENT(expected).key("warmReconnect")
+                .displayedName("Warm Reconnect")
+                .description("On connect, compare a fingerprint of the hardware state (serial, build stamps, PLL, "
+                             "key EPC registers, active IOBs) with the one stored by the last session and skip "
+                             "reset and PLL programming if they match")
+                .assignmentOptional().defaultValue(false).reconfigurable()
+                .allowedStates(State::UNKNOWN)
+                .expertAccess()
+                .commit();
+
+        STRING_ELEMENT(expected).key("connectMode")
+                .displayedName("Connect Mode")
+                .description("COLD: PPT was reset on connect, WARM: running PPT was taken over")
+                .readOnly()
+                .defaultValue("")
+                .commit();
+
+        STRING_ELEMENT(expected).key("fingerprintMismatch")
+                .displayedName("Fingerprint Mismatch")
+                .description("Fingerprint fields which differed from the last session on the last connect")
+                .readOnly()
+                .defaultValue("")
+                .expertAccess()
+                .commit();
+
+        BOOL_ELEMENT(expected).key("telemetryConnected")
+                .displayedName("Telemetry Connected")
+                .description("Telemetry is read via the dedicated second connection")
+                .readOnly()
+                .defaultValue(false)
+                .expertAccess()
+                .commit();
+
         SLOT_ELEMENT(expected)
                 .key("open").displayedName("Connect PPT").description("Open connection to PPT")
                 .allowedStates(State::UNKNOWN)
@@ -401,6 +451,25 @@ namespace karabo {
                 .minInc(1)
                 .commit();
 
+        STRING_ELEMENT(expected).key("burstMode")
+                .displayedName("Burst Mode")
+                .description("SOFTWARE: the device watches the train ids and stops the acquisition, "
+                             "HARDWARE: the PPT sends numBurstTrains single cycles and stops by itself, "
+                             "falls back to SOFTWARE if the firmware can not count the cycles")
+                .assignmentOptional().defaultValue("SOFTWARE").reconfigurable()
+                .options("SOFTWARE,HARDWARE")
+                .commit();
+
+        STRING_ELEMENT(expected).key("burstHardwareMinFirmware")
+                .displayedName("Burst Hardware Min Firmware")
+                .description("Build stamp of the first PPT firmware counting the single cycles of a HARDWARE burst, "
+                             "older firmware uses SOFTWARE. Empty: no firmware known, always SOFTWARE. To enable "
+                             "HARDWARE bursts set it to the firmwareRev of a firmware verified to stop after "
+                             "Single_Cycle_Register.iterations cycles")
+                .assignmentOptional().defaultValue("").reconfigurable()
+                .expertAccess()
+                .commit();
+
         SLOT_ELEMENT(expected)
                 .key("startBurstAcquisition").displayedName("Start Burst Acquisition").description("Send burst of trains")
                 .allowedStates(State::ON)
@@ -415,16 +484,48 @@ namespace karabo {
 
         UINT64_ELEMENT(expected).key("burstData.startTrainId")
                 .displayedName("startTrainId")
-                .description("start train of burst measurement")
+                .description("start train of burst measurement, planned in HARDWARE mode")
                 .assignmentOptional().defaultValue(0).reconfigurable()
                 .commit();
                 
         UINT64_ELEMENT(expected).key("burstData.endTrainId")
                 .displayedName("endTrainId")
-                .description("end train of burst measurement")
+                .description("end train of burst measurement, planned in HARDWARE mode")
                 .assignmentOptional().defaultValue(0).reconfigurable()
                 .commit();
 
+        STRING_ELEMENT(expected).key("burstData.mode")
+                .displayedName("mode")
+                .description("burst mode used for the last burst measurement")
+                .readOnly().defaultValue("")
+                .commit();
+
+        UINT32_ELEMENT(expected).key("burstData.numTrains")
+                .displayedName("numTrains")
+                .description("trains from startTrainId to endTrainId, equals numBurstTrains for an exact burst")
+                .readOnly().defaultValue(0)
+                .commit();
+
+        BOOL_ELEMENT(expected).key("burstData.planned")
+                .displayedName("planned")
+                .description("startTrainId and endTrainId are the trains the HARDWARE burst was armed for, "
+                             "not trains seen. Skipped or late trains show in doneTrainId")
+                .readOnly().defaultValue(false)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("burstData.doneTrainId")
+                .displayedName("doneTrainId")
+                .description("train id read when the end of the burst was seen, in HARDWARE mode with the PPT "
+                             "reporting the last cycle done. 0 if the burst was stopped before")
+                .readOnly().defaultValue(0)
+                .commit();
+
+        UINT32_ELEMENT(expected).key("burstData.numTrainIdReads")
+                .displayedName("numTrainIdReads")
+                .description("train id reads of the last burst measurement")
+                .readOnly().defaultValue(0)
+                .commit();
+
         STRING_ELEMENT(expected).key("selRegName")
                 .displayedName("Register")
                 .description("Select Register to program")
@@ -1055,6 +1156,82 @@ namespace karabo {
                 .expertAccess()
                 .commit();
 
+        SLOT_ELEMENT(expected)
+                .key("autoTuneThrottle")
+                .displayedName("Auto Tune Throttle")
+                .description("Search the smallest throttle divider without frame loss while acquiring, starting from the "
+                             "current divider. Frame loss is fed back by the receivers via throttleTuning.frameLoss or "
+                             "throttleTuning.frameLossCount, tuning requires throttleTuning.feedbackSource to be set")
+                .allowedStates(State::ACQUIRING)
+                .expertAccess()
+                .commit();
+
+        SLOT_ELEMENT(expected)
+                .key("applyTunedThrottle")
+                .displayedName("Apply Tuned Throttle")
+                .description("Set the throttle divider tuned for the current receiver configuration")
+                .expertAccess()
+                .commit();
+
+        NODE_ELEMENT(expected).key("throttleTuning")
+                .displayedName("Throttle Tuning")
+                .description("Auto tuning of the ethernet throttle divider, results are stored per receiver configuration")
+                .expertAccess()
+                .commit();
+
+        STRING_ELEMENT(expected).key("throttleTuning.feedbackSource")
+                .displayedName("Feedback Source")
+                .description("Receiver device feeding back the frame loss, without it no loss can be seen and tuning is refused")
+                .assignmentOptional().defaultValue("").reconfigurable()
+                .commit();
+
+        UINT32_ELEMENT(expected).key("throttleTuning.testTrains")
+                .displayedName("Test Trains")
+                .description("Trains sent with every divider tested")
+                .assignmentOptional().defaultValue(50).reconfigurable()
+                .minInc(10)
+                .commit();
+
+        BOOL_ELEMENT(expected).key("throttleTuning.frameLoss")
+                .displayedName("Frame Loss")
+                .description("Set by the receivers if frames were lost, cleared before every test")
+                .assignmentOptional().defaultValue(false).reconfigurable()
+                .commit();
+
+        UINT64_ELEMENT(expected).key("throttleTuning.frameLossCount")
+                .displayedName("Frame Loss Count")
+                .description("Lost frame counter of the receivers, frames were lost if it increased during a test")
+                .assignmentOptional().defaultValue(0).reconfigurable()
+                .commit();
+
+        UINT32_ELEMENT(expected).key("throttleTuning.storedDivider")
+                .displayedName("Stored Divider")
+                .description("Divider tuned for the current receiver configuration")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        DOUBLE_ELEMENT(expected).key("throttleTuning.readoutWindowBefore")
+                .displayedName("Readout Window Before")
+                .description("Time to send the data of one train with the divider before tuning in ms")
+                .readOnly()
+                .defaultValue(0.0)
+                .commit();
+
+        DOUBLE_ELEMENT(expected).key("throttleTuning.readoutWindowAfter")
+                .displayedName("Readout Window After")
+                .description("Time to send the data of one train with the tuned divider in ms")
+                .readOnly()
+                .defaultValue(0.0)
+                .commit();
+
+        DOUBLE_ELEMENT(expected).key("throttleTuning.readoutWindowShrink")
+                .displayedName("Readout Window Shrink")
+                .description("Readout window saved per train by the tuning in ms")
+                .readOnly()
+                .defaultValue(0.0)
+                .commit();
+
         init_enable_datapath_elements(expected);
 
         SLOT_ELEMENT(expected)
@@ -1068,6 +1245,14 @@ namespace karabo {
                 .displayedName("Input")
                 .commit();
 
+        Schema telemetrySchema;
+        OUTPUT_CHANNEL(expected).key("telemetryOutput")
+                .displayedName("Telemetry Output")
+                .description("Telemetry samples (timestamp, trainId, pptTemp, ethOutputRate, iobTemp), "
+                             "see telemetry.outputDownsampling")
+                .dataSchema(telemetrySchema)
+                .commit();
+
         BOOL_ELEMENT(expected)
                 .key("iobProgrammed")
                 .displayedName("IOB programmed")
@@ -1095,163 +1280,876 @@ namespace karabo {
                 .expertAccess()
                 .commit();
 
-        VECTOR_STRING_ELEMENT(expected)
-                .key("availableScenes")
-                .setSpecialDisplayType(KARABO_SCHEMA_DISPLAY_TYPE_SCENES)
-                .readOnly()
-                .defaultValue(std::vector<std::string>{"overview", "configurator"})
-                .expertAccess()
+        NODE_ELEMENT(expected).key("operation")
+                .displayedName("Operation Progress")
+                .description("Progress of the running long operation (initSystem, programAllIOBFPGAs, updateFirmwareFlash, programJTAGAllModules, fillSramAndReadout)")
                 .commit();
-    }
 
-    const std::string DsscPpt::s_dsscConfBaseNode = "DetectorRegisters";
-    
-    DsscPpt::DsscPpt(const karabo::data::Hash& config)
-        : Device(config),
-        m_keepAcquisition(false), m_keepPolling(false), m_burstAcquisition(false),
-        m_pollThread(),
-        m_ppt(),
-        m_epcTag("epcParam"), m_dsscConfigtoSchema() {
-        
-        EventLoop::addThread(16);
+        SLOT_ELEMENT(expected)
+                .key("abortOperation").displayedName("Abort Operation")
+                .description("Abort the running long operation after its current step")
+                .commit();
 
-        KARABO_INITIAL_FUNCTION(initialize);
+        STRING_ELEMENT(expected).key("operation.name")
+                .displayedName("Name")
+                .description("Name of the running or last operation")
+                .readOnly()
+                .defaultValue("")
+                .commit();
 
-        KARABO_SLOT(open);
-        KARABO_SLOT(close);
-        KARABO_SLOT(runXFEL);
-        KARABO_SLOT(runStandAlone);
-        KARABO_SLOT(stopStandalone);
-        KARABO_SLOT(stopAcquisition);
-        KARABO_SLOT(startManualBurstBtn);
-        KARABO_SLOT(startAcquisition);
-        KARABO_SLOT(startBurstAcquisition);
-        KARABO_SLOT(startAllChannelsDummyData);
+        STRING_ELEMENT(expected).key("operation.step")
+                .displayedName("Step")
+                .description("Current step of the operation")
+                .readOnly()
+                .defaultValue("")
+                .commit();
 
-        KARABO_SLOT(updateFirmwareFlash);
-        KARABO_SLOT(updateLinuxFlash);
-        KARABO_SLOT(updateIOBFirmware);
-        KARABO_SLOT(initSystem);
-        KARABO_SLOT(initSingleModule);
-        KARABO_SLOT(updateGuiRegisters);
+        DOUBLE_ELEMENT(expected).key("operation.percent")
+                .displayedName("Progress")
+                .description("Completed steps of the operation")
+                .unit(Unit::PERCENT)
+                .readOnly()
+                .defaultValue(0.0)
+                .commit();
 
+        DOUBLE_ELEMENT(expected).key("operation.elapsed")
+                .displayedName("Elapsed")
+                .description("Time since the operation started")
+                .unit(Unit::SECOND)
+                .readOnly()
+                .defaultValue(0.0)
+                .commit();
 
-        KARABO_SLOT(programAllIOBFPGAs);
-        KARABO_SLOT(programIOB1FPGA);
-        KARABO_SLOT(programIOB2FPGA);
-        KARABO_SLOT(programIOB3FPGA);
-        KARABO_SLOT(programIOB4FPGA);
-        KARABO_SLOT(checkAllIOBStatus);
+        DOUBLE_ELEMENT(expected).key("operation.eta")
+                .displayedName("ETA")
+                .description("Estimated remaining time, extrapolated from the completed steps. Negative if unknown")
+                .unit(Unit::SECOND)
+                .readOnly()
+                .defaultValue(-1.0)
+                .commit();
 
-        KARABO_SLOT(preProgSelReg);
-        KARABO_SLOT(progSelReg);
-        KARABO_SLOT(readSelReg);
+        STRING_ELEMENT(expected).key("operation.result")
+                .displayedName("Result")
+                .description("IDLE, RUNNING, FINISHED or ABORTED")
+                .readOnly()
+                .defaultValue("IDLE")
+                .commit();
 
-        KARABO_SLOT(programJTAG);
-        KARABO_SLOT(programPixelRegister);
-        KARABO_SLOT(programPixelRegisterDefault);
-        KARABO_SLOT(updateSequencer);
+        NODE_ELEMENT(expected).key("pptTiming")
+                .displayedName("PPT Call Timing")
+                .description("Rolling duration statistics of the calls to the PPT, over the last 256 calls per operation")
+                .expertAccess()
+                .commit();
 
-        KARABO_SLOT(doFastInit);
-        KARABO_SLOT(initChip);
+        SLOT_ELEMENT(expected)
+                .key("dumpPptTiming").displayedName("Dump PPT Timing")
+                .description("Refresh the PPT call timing and write it as a table to the log")
+                .expertAccess()
+                .commit();
 
-        KARABO_SLOT(updateStartWaitOffset);
-        KARABO_SLOT(updateSequenceCounters);
-        KARABO_SLOT(programLMKOutput);
+        VECTOR_STRING_ELEMENT(expected).key("pptTiming.operations")
+                .displayedName("Operations")
+                .description("PPT operations called")
+                .readOnly()
+                .defaultValue(std::vector<std::string>())
+                .commit();
 
-        KARABO_SLOT(resetAllBtn);
-        KARABO_SLOT(resetEPC);
-        KARABO_SLOT(resetIOBs);
-        KARABO_SLOT(resetDatapath);
-        KARABO_SLOT(resetASICs);
-        KARABO_SLOT(programEPCConfig);
-        KARABO_SLOT(readEPCRegisters);
+        VECTOR_UINT64_ELEMENT(expected).key("pptTiming.counts")
+                .displayedName("Counts")
+                .description("Total number of calls per operation")
+                .readOnly()
+                .defaultValue(std::vector<unsigned long long>())
+                .commit();
 
-        KARABO_SLOT(setBurstParameter);
-        KARABO_SLOT(setSequencerParameter);
-        KARABO_SLOT(storePoweredPixels);
-        KARABO_SLOT(restorePoweredPixels);
-        KARABO_SLOT(setCurrentQuarterOn);
-        KARABO_SLOT(setCurrentColSkipOn);
+        VECTOR_DOUBLE_ELEMENT(expected).key("pptTiming.p50")
+                .displayedName("Median")
+                .description("Median call duration per operation, in ms")
+                .readOnly()
+                .defaultValue(std::vector<double>())
+                .commit();
 
-        KARABO_SLOT(setInjectionValue);
-        KARABO_SLOT(setIntDACMode);
-        KARABO_SLOT(setNormalMode);
-        KARABO_SLOT(setPixelInjectionMode);
-        KARABO_SLOT(setInjectionMode);
+        VECTOR_DOUBLE_ELEMENT(expected).key("pptTiming.p95")
+                .displayedName("95th Percentile")
+                .description("95th percentile of the call duration per operation, in ms")
+                .readOnly()
+                .defaultValue(std::vector<double>())
+                .commit();
 
-        KARABO_SLOT(setQuadrantSetup);
+        VECTOR_DOUBLE_ELEMENT(expected).key("pptTiming.max")
+                .displayedName("Maximum")
+                .description("Longest call duration per operation, in ms")
+                .readOnly()
+                .defaultValue(std::vector<double>())
+                .commit();
 
-        KARABO_SLOT(resetAurora1);
-        KARABO_SLOT(programLMK1);
-        KARABO_SLOT(programIOB1Config);
-        KARABO_SLOT(readIOBRegisters1);
+        NODE_ELEMENT(expected).key("telemetry")
+                .displayedName("Telemetry")
+                .description("Periodic reads of PPT temperature, output rate and, during burst acquisition, train id. "
+                             "Reads falling due together are done under one PPT lock")
+                .expertAccess()
+                .commit();
 
-        KARABO_SLOT(resetAurora2);
-        KARABO_SLOT(programLMK2);
-        KARABO_SLOT(programIOB2Config);
-        KARABO_SLOT(readIOBRegisters2);
+        UINT32_ELEMENT(expected).key("telemetry.idleInterval")
+                .displayedName("Idle Interval")
+                .description("Telemetry interval in ms if the detector is not operated, the output rate is not read")
+                .assignmentOptional().defaultValue(10000).reconfigurable()
+                .minInc(100)
+                .commit();
 
-        KARABO_SLOT(resetAurora3);
-        KARABO_SLOT(programLMK3);
-        KARABO_SLOT(programIOB3Config);
-        KARABO_SLOT(readIOBRegisters3);
+        UINT32_ELEMENT(expected).key("telemetry.onInterval")
+                .displayedName("On Interval")
+                .description("Telemetry interval in states ON, STARTED and STOPPED in ms")
+                .assignmentOptional().defaultValue(5000).reconfigurable()
+                .minInc(100)
+                .commit();
 
-        KARABO_SLOT(resetAurora4);
-        KARABO_SLOT(programLMK4);
-        KARABO_SLOT(programIOB4Config);
-        KARABO_SLOT(readIOBRegisters4);
+        UINT32_ELEMENT(expected).key("telemetry.acquiringInterval")
+                .displayedName("Acquiring Interval")
+                .description("Telemetry interval while acquiring in ms")
+                .assignmentOptional().defaultValue(2000).reconfigurable()
+                .minInc(100)
+                .commit();
 
-        KARABO_SLOT(programPLL);
+        UINT32_ELEMENT(expected).key("telemetry.outputDownsampling")
+                .displayedName("Output Downsampling")
+                .description("Write every n-th telemetry sample to telemetryOutput, 0 disables the output. "
+                             "All samples are kept in the history returned by slot getTelemetryHistory")
+                .assignmentOptional().defaultValue(1).reconfigurable()
+                .commit();
 
-        KARABO_SLOT(saveConfigIOB);
-        KARABO_SLOT(saveConfiguration);
-        KARABO_SLOT(storeFullConfigFile);
-        KARABO_SLOT(storeFullConfigUnder);
+        STRING_ELEMENT(expected).key("telemetry.mode")
+                .displayedName("Mode")
+                .description("Telemetry mode selecting the intervals: IDLE, ON or ACQUIRING")
+                .readOnly()
+                .defaultValue("IDLE")
+                .commit();
 
-        KARABO_SLOT(setSendingASICs);
-        KARABO_SLOT(programLMKsAuto);
+        UINT64_ELEMENT(expected).key("telemetry.numBatches")
+                .displayedName("Batches")
+                .description("Telemetry batches, each one PPT lock")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
 
-        KARABO_SLOT(checkIOBDataFailed);
-        KARABO_SLOT(checkPPTDataFailed);
-        KARABO_SLOT(checkASICReset);
-        KARABO_SLOT(fillSramAndReadout);
-        KARABO_SLOT(readLastPPTTrainID);
+        UINT64_ELEMENT(expected).key("telemetry.numReads")
+                .displayedName("Reads")
+                .description("Telemetry values read")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
 
-        KARABO_SLOT(waitJTAGEngineDone);
-        KARABO_SLOT(loadLastFileETHConfig);
-        KARABO_SLOT(checkQSFPConnected);
+        UINT64_ELEMENT(expected).key("telemetry.numSkipped")
+                .displayedName("Skipped Batches")
+                .description("Batches skipped because the PPT was busy")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
 
-        KARABO_SLOT(setThrottleDivider);
+        NODE_ELEMENT(expected).key("linkHealth")
+                .displayedName("Link Health")
+                .description("Samples the ASIC channel readout failures and the aurora status of the active IOBs, "
+                             "one register read per interval, in turn. Counts and failure rates are in the iob status nodes")
+                .expertAccess()
+                .commit();
 
-        KARABO_SLOT(startSingleCycle);
-        
-        KARABO_SLOT(updateConfigHash);
-        KARABO_SLOT(updateConfigFromHash);
-        KARABO_SLOT(requestScene, Hash);
-    }
+        UINT32_ELEMENT(expected).key("linkHealth.interval")
+                .displayedName("Interval")
+                .description("Sampling interval in ms if the detector is operated, 0 disables the sampling")
+                .assignmentOptional().defaultValue(1000).reconfigurable()
+                .commit();
 
-    void DsscPpt::preDestruction() {
+        STRING_ELEMENT(expected).key("linkHealth.summary")
+                .displayedName("Summary")
+                .description("Failure rates of the last 10 min of failing ASICs and IOBs with aurora not ready")
+                .readOnly()
+                .defaultValue("all links ok")
+                .commit();
 
-        if (this->getState() != State::ERROR) {
-            const string defaultConfigPath = DEFAULTCONF;
-            m_ppt->storeFullConfigFile(defaultConfigPath);
-            this->stop();
-        }
-        
-        if (m_pollThread && m_pollThread->joinable()) {
-            m_keepPolling = false;
-            m_pollThread->join();
-        }
-      
-    }
-    
-    DsscPpt::~DsscPpt() {
-        EventLoop::removeThread(16);
-    }
+        SLOT_ELEMENT(expected)
+                .key("resetLinkHealth").displayedName("Reset Link Health")
+                .description("Clear the link failure counts and rates")
+                .expertAccess()
+                .commit();
 
-    void DsscPpt::initialize() {
-        this->updateState(State::INIT);
+        NODE_ELEMENT(expected).key("lastSession")
+                .displayedName("Last Session")
+                .description("Summary of the last acquisition session, the last 100 sessions are returned by slot getSessionHistory")
+                .commit();
+
+        DOUBLE_ELEMENT(expected).key("lastSession.startTime")
+                .displayedName("Start Time")
+                .description("Seconds since epoch")
+                .readOnly()
+                .defaultValue(0.0)
+                .commit();
+
+        DOUBLE_ELEMENT(expected).key("lastSession.stopTime")
+                .displayedName("Stop Time")
+                .description("Seconds since epoch")
+                .readOnly()
+                .defaultValue(0.0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("lastSession.firstTrainId")
+                .displayedName("First Train Id")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("lastSession.lastTrainId")
+                .displayedName("Last Train Id")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("lastSession.trainsExpected")
+                .displayedName("Trains Expected")
+                .description("Trains of 10 Hz during the session")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("lastSession.trainsSeen")
+                .displayedName("Trains Seen")
+                .description("Trains expected without the ones lost in train id gaps")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("lastSession.numGaps")
+                .displayedName("Gaps")
+                .description("Train id jumps, freezes and resets")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        DOUBLE_ELEMENT(expected).key("lastSession.efficiency")
+                .displayedName("Efficiency")
+                .description("Trains seen of the trains expected in percent")
+                .readOnly()
+                .defaultValue(0.0)
+                .commit();
+
+        DOUBLE_ELEMENT(expected).key("lastSession.meanOutputRate")
+                .displayedName("Mean Output Rate")
+                .description("Mean of the sampled output rates in MBit/s")
+                .readOnly()
+                .defaultValue(0.0)
+                .commit();
+
+        DOUBLE_ELEMENT(expected).key("lastSession.minOutputRate")
+                .displayedName("Min Output Rate")
+                .description("Lowest sampled output rate in MBit/s")
+                .readOnly()
+                .defaultValue(0.0)
+                .commit();
+
+        DOUBLE_ELEMENT(expected).key("lastSession.recoveryTime")
+                .displayedName("Recovery Time")
+                .description("Time spent in stall recoveries in s")
+                .readOnly()
+                .defaultValue(0.0)
+                .commit();
+
+        DOUBLE_ELEMENT(expected).key("lastSession.lockWaitTime")
+                .displayedName("Lock Wait Time")
+                .description("Time waited for the PPT lock during the session in ms")
+                .readOnly()
+                .defaultValue(0.0)
+                .commit();
+
+        NODE_ELEMENT(expected).key("watchdog")
+                .displayedName("Stall Watchdog")
+                .description("Detects stalled train ids, missing output data and failing ASIC channels while acquiring "
+                             "and recovers the failing IOBs by an aurora reset, then by a re-init of the IOB")
+                .expertAccess()
+                .commit();
+
+        BOOL_ELEMENT(expected).key("watchdog.enable")
+                .displayedName("Enable")
+                .description("Watch acquisitions for stalls and recover automatically")
+                .assignmentOptional().defaultValue(false).reconfigurable()
+                .commit();
+
+        UINT32_ELEMENT(expected).key("watchdog.stallTrains")
+                .displayedName("Stall Trains")
+                .description("Trains without progress until a stall is detected")
+                .assignmentOptional().defaultValue(20).reconfigurable()
+                .minInc(2)
+                .commit();
+
+        STRING_ELEMENT(expected).key("watchdog.status")
+                .displayedName("Status")
+                .description("WATCHING, RECOVERING, VERIFYING a recovery or GAVE_UP until the stall clears")
+                .readOnly()
+                .defaultValue("WATCHING")
+                .commit();
+
+        UINT64_ELEMENT(expected).key("watchdog.numStalls")
+                .displayedName("Stalls")
+                .description("Stalls detected")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("watchdog.numRecoveries")
+                .displayedName("Recoveries")
+                .description("Recovery actions run")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("watchdog.numRecovered")
+                .displayedName("Recovered")
+                .description("Stalls cleared by a recovery action")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("watchdog.numFailedRecoveries")
+                .displayedName("Failed Recoveries")
+                .description("Recovery actions after which the stall persisted")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("watchdog.lastRecoveryTime")
+                .displayedName("Last Recovery Time")
+                .description("Time from detection of the last recovered stall to the end of its recovery in ms")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        NODE_ELEMENT(expected).key("jtagProgramming")
+                .displayedName("JTAG Programming")
+                .description("Delta programming shifts only the JTAG module sets which differ from the values last "
+                             "programmed into the module")
+                .expertAccess()
+                .commit();
+
+        BOOL_ELEMENT(expected).key("jtagProgramming.deltaEnable")
+                .displayedName("Delta Programming")
+                .description("Skip JTAG module sets unchanged since they were last programmed when a configuration "
+                             "is received, programJTAG always shifts all module sets")
+                .assignmentOptional().defaultValue(false).reconfigurable()
+                .commit();
+
+        UINT64_ELEMENT(expected).key("jtagProgramming.lastBitsRequested")
+                .displayedName("Last Bits Requested")
+                .description("Bits of all module sets of the last delta programming")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("jtagProgramming.lastBitsShifted")
+                .displayedName("Last Bits Shifted")
+                .description("Bits of the dirty module sets shifted by the last delta programming")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("jtagProgramming.bitsRequested")
+                .displayedName("Bits Requested")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("jtagProgramming.bitsShifted")
+                .displayedName("Bits Shifted")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        NODE_ELEMENT(expected).key("broadcastProgramming")
+                .displayedName("Broadcast Programming")
+                .description("Programming all modules programs the JTAG of the modules with identical content in one "
+                             "pass, with the JTAG engines of all of them enabled")
+                .expertAccess()
+                .commit();
+
+        BOOL_ELEMENT(expected).key("broadcastProgramming.enable")
+                .displayedName("Enable")
+                .description("Broadcast identical JTAG content, otherwise the modules are programmed one by one")
+                .assignmentOptional().defaultValue(true).reconfigurable()
+                .commit();
+
+        UINT32_ELEMENT(expected).key("broadcastProgramming.lastModules")
+                .displayedName("Last Modules")
+                .description("Modules programmed by the last programming of all modules")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT32_ELEMENT(expected).key("broadcastProgramming.lastPasses")
+                .displayedName("Last Passes")
+                .description("Programming passes needed by the last programming of all modules")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("broadcastProgramming.modulesProgrammed")
+                .displayedName("Modules Programmed")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("broadcastProgramming.passes")
+                .displayedName("Passes")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        NODE_ELEMENT(expected).key("pixelProgramming")
+                .displayedName("Pixel Programming")
+                .description("Delta programming writes only the pixels changed since the last programming, by the "
+                             "cheapest of a full stream, a broadcast of equal pixels or addressed writes per pixel")
+                .expertAccess()
+                .commit();
+
+        BOOL_ELEMENT(expected).key("pixelProgramming.deltaEnable")
+                .displayedName("Delta Programming")
+                .description("Program only the changed pixels if cheaper than the full stream. A programming "
+                             "with read back always shifts the full stream")
+                .assignmentOptional().defaultValue(false).reconfigurable()
+                .commit();
+
+        UINT32_ELEMENT(expected).key("pixelProgramming.directOverheadBits")
+                .displayedName("Direct Write Overhead")
+                .description("Bits shifted in addition to the pixel register to address one pixel")
+                .assignmentOptional().defaultValue(200).reconfigurable()
+                .commit();
+
+        STRING_ELEMENT(expected).key("pixelProgramming.lastStrategy")
+                .displayedName("Last Strategy")
+                .description("NONE, FULL, UNIFORM or DIRECT")
+                .readOnly()
+                .defaultValue("NONE")
+                .commit();
+
+        UINT32_ELEMENT(expected).key("pixelProgramming.lastChangedPixels")
+                .displayedName("Last Changed Pixels")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("pixelProgramming.lastBits")
+                .displayedName("Last Bits")
+                .description("Bits shifted by the last programming")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("pixelProgramming.lastFullBits")
+                .displayedName("Last Full Bits")
+                .description("Bits of the full stream for comparison")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        DOUBLE_ELEMENT(expected).key("pixelProgramming.lastTime")
+                .displayedName("Last Time")
+                .description("Duration of the last programming in ms")
+                .readOnly()
+                .defaultValue(0.0)
+                .commit();
+
+        NODE_ELEMENT(expected).key("configUpdate")
+                .displayedName("Configuration Update")
+                .description("Changes of the detector registry are applied first, then every affected module set is "
+                             "programmed once")
+                .expertAccess()
+                .commit();
+
+        UINT32_ELEMENT(expected).key("configUpdate.lastChanges")
+                .displayedName("Last Changes")
+                .description("Changed values of the last update, each one was a program operation before grouping")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT32_ELEMENT(expected).key("configUpdate.lastProgramOperations")
+                .displayedName("Last Program Operations")
+                .description("Module sets programmed by the last update")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        NODE_ELEMENT(expected).key("hotReconfig")
+                .displayedName("Hot Reconfiguration")
+                .description("Register changes safe between trains are written at the next train gap while running, "
+                             "all others are written immediately as before. Safe registers are comma separated module sets, "
+                             "moduleSet/signal names or prefixes ending with '*'")
+                .expertAccess()
+                .commit();
+
+        BOOL_ELEMENT(expected).key("hotReconfig.enable")
+                .displayedName("Enable")
+                .description("Write safe register changes while running")
+                .assignmentOptional().defaultValue(false).reconfigurable()
+                .commit();
+
+        UINT32_ELEMENT(expected).key("hotReconfig.trainGapDelay")
+                .displayedName("Train Gap Delay")
+                .description("Delay after the start of a train until the sequencer is idle in ms")
+                .assignmentOptional().defaultValue(50).reconfigurable()
+                .maxInc(90)
+                .commit();
+
+        STRING_ELEMENT(expected).key("hotReconfig.safeEPC")
+                .displayedName("Safe EPC")
+                .assignmentOptional().defaultValue(HotReconfigPolicy::defaultSafePatterns().at("EPC")).reconfigurable()
+                .commit();
+
+        STRING_ELEMENT(expected).key("hotReconfig.safeIOB")
+                .displayedName("Safe IOB")
+                .assignmentOptional().defaultValue(HotReconfigPolicy::defaultSafePatterns().at("IOB")).reconfigurable()
+                .commit();
+
+        STRING_ELEMENT(expected).key("hotReconfig.safeJTAG")
+                .displayedName("Safe JTAG")
+                .assignmentOptional().defaultValue(HotReconfigPolicy::defaultSafePatterns().at("JTAG")).reconfigurable()
+                .commit();
+
+        STRING_ELEMENT(expected).key("hotReconfig.safeSequence")
+                .displayedName("Safe Sequence Counters")
+                .assignmentOptional().defaultValue(HotReconfigPolicy::defaultSafePatterns().at("SEQ")).reconfigurable()
+                .commit();
+
+        UINT64_ELEMENT(expected).key("hotReconfig.numHotWrites")
+                .displayedName("Hot Writes")
+                .description("Reconfigurations written while running in the train gaps")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("hotReconfig.numUnsafeWrites")
+                .displayedName("Unsafe Writes")
+                .description("Reconfigurations written while running which are not safe between trains, "
+                             "they are written immediately without waiting for a train gap")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("hotReconfig.numOverruns")
+                .displayedName("Overruns")
+                .description("Reconfigurations written while running which did not finish before the next train")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        NODE_ELEMENT(expected).key("verification")
+                .displayedName("Deferred Verification")
+                .description("Readback verification of JTAG, pixel and sequencer programming in DEFERRED readBackMode")
+                .expertAccess()
+                .commit();
+
+        UINT32_ELEMENT(expected).key("verification.pending")
+                .displayedName("Pending")
+                .description("Verification jobs waiting or running")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("verification.numVerified")
+                .displayedName("Verified")
+                .description("Module sets verified")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("verification.numMismatches")
+                .displayedName("Mismatches")
+                .description("Module sets which did not read back correctly")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("verification.numCancelled")
+                .displayedName("Cancelled")
+                .description("Module sets not verified because the acquisition was started before their readback")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        VECTOR_STRING_ELEMENT(expected).key("verification.mismatches")
+                .displayedName("Mismatching Module Sets")
+                .description("Module sets (IOB/register/module set) which failed their last verification")
+                .readOnly()
+                .defaultValue(std::vector<std::string>())
+                .commit();
+
+        NODE_ELEMENT(expected).key("readbackCache")
+                .displayedName("Readback Cache")
+                .description("Register readbacks repeated within the time to live use the values read before "
+                             "instead of a hardware round trip. Programming or resetting a register invalidates it")
+                .expertAccess()
+                .commit();
+
+        UINT32_ELEMENT(expected).key("readbackCache.timeToLive")
+                .displayedName("Time To Live")
+                .description("Time a readback stays valid in ms, 0 disables the cache. Status registers are always read back")
+                .assignmentOptional().defaultValue(0).reconfigurable()
+                .commit();
+
+        UINT64_ELEMENT(expected).key("readbackCache.hits")
+                .displayedName("Hits")
+                .description("Readbacks answered from the cache")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        UINT64_ELEMENT(expected).key("readbackCache.misses")
+                .displayedName("Misses")
+                .description("Readbacks sent to the hardware")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        NODE_ELEMENT(expected).key("lockStats")
+                .displayedName("PPT Lock Statistics")
+                .description("Wait and hold times of the PPT access lock per calling function")
+                .expertAccess()
+                .commit();
+
+        SLOT_ELEMENT(expected)
+                .key("updateLockStats").displayedName("Update Lock Statistics")
+                .description("Refresh the PPT lock statistics, also done by the hardware polling")
+                .expertAccess()
+                .commit();
+
+        UINT64_ELEMENT(expected).key("lockStats.telemetryDropped")
+                .displayedName("Telemetry Dropped")
+                .description("Telemetry reads skipped because the PPT was busy with control or programming commands")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        VECTOR_STRING_ELEMENT(expected).key("lockStats.origins")
+                .displayedName("Origins")
+                .description("Functions which acquired the PPT access lock")
+                .readOnly()
+                .defaultValue(std::vector<std::string>())
+                .commit();
+
+        VECTOR_UINT64_ELEMENT(expected).key("lockStats.counts")
+                .displayedName("Counts")
+                .description("Number of lock acquisitions per origin")
+                .readOnly()
+                .defaultValue(std::vector<unsigned long long>())
+                .commit();
+
+        VECTOR_DOUBLE_ELEMENT(expected).key("lockStats.waitP50")
+                .displayedName("Wait Median")
+                .description("Median time waited for the lock per origin, in ms")
+                .readOnly()
+                .defaultValue(std::vector<double>())
+                .commit();
+
+        VECTOR_DOUBLE_ELEMENT(expected).key("lockStats.waitP95")
+                .displayedName("Wait 95th Percentile")
+                .description("95th percentile of the time waited for the lock per origin, in ms")
+                .readOnly()
+                .defaultValue(std::vector<double>())
+                .commit();
+
+        VECTOR_DOUBLE_ELEMENT(expected).key("lockStats.waitMax")
+                .displayedName("Wait Maximum")
+                .description("Longest time waited for the lock per origin, in ms")
+                .readOnly()
+                .defaultValue(std::vector<double>())
+                .commit();
+
+        VECTOR_DOUBLE_ELEMENT(expected).key("lockStats.holdP50")
+                .displayedName("Hold Median")
+                .description("Median time the lock was held per origin, in ms")
+                .readOnly()
+                .defaultValue(std::vector<double>())
+                .commit();
+
+        VECTOR_DOUBLE_ELEMENT(expected).key("lockStats.holdP95")
+                .displayedName("Hold 95th Percentile")
+                .description("95th percentile of the time the lock was held per origin, in ms")
+                .readOnly()
+                .defaultValue(std::vector<double>())
+                .commit();
+
+        VECTOR_DOUBLE_ELEMENT(expected).key("lockStats.holdMax")
+                .displayedName("Hold Maximum")
+                .description("Longest time the lock was held per origin, in ms")
+                .readOnly()
+                .defaultValue(std::vector<double>())
+                .commit();
+
+        VECTOR_STRING_ELEMENT(expected)
+                .key("availableScenes")
+                .setSpecialDisplayType(KARABO_SCHEMA_DISPLAY_TYPE_SCENES)
+                .readOnly()
+                .defaultValue(std::vector<std::string>{"overview", "configurator"})
+                .expertAccess()
+                .commit();
+    }
+
+    const std::string DsscPpt::s_dsscConfBaseNode = "DetectorRegisters";
+    
+    DsscPpt::DsscPpt(const karabo::data::Hash& config)
+        : Device(config),
+        m_keepAcquisition(false), m_burstAcquisition(false),
+        m_ppt(),
+        m_numPendingVerifications(0), m_numVerified(0), m_numMismatches(0), m_numCancelledVerifications(0),
+        m_epcTag("epcParam"), m_dsscConfigtoSchema() {
+        
+        EventLoop::addThread(16);
+
+        KARABO_INITIAL_FUNCTION(initialize);
+
+        KARABO_SLOT(open);
+        KARABO_SLOT(close);
+        KARABO_SLOT(runXFEL);
+        KARABO_SLOT(runStandAlone);
+        KARABO_SLOT(stopStandalone);
+        KARABO_SLOT(stopAcquisition);
+        KARABO_SLOT(startManualBurstBtn);
+        KARABO_SLOT(startAcquisition);
+        KARABO_SLOT(startBurstAcquisition);
+        KARABO_SLOT(startAllChannelsDummyData);
+
+        KARABO_SLOT(updateFirmwareFlash);
+        KARABO_SLOT(updateLinuxFlash);
+        KARABO_SLOT(updateIOBFirmware);
+        KARABO_SLOT(initSystem);
+        KARABO_SLOT(initSingleModule);
+        KARABO_SLOT(updateGuiRegisters);
+
+
+        KARABO_SLOT(programAllIOBFPGAs);
+        KARABO_SLOT(programIOB1FPGA);
+        KARABO_SLOT(programIOB2FPGA);
+        KARABO_SLOT(programIOB3FPGA);
+        KARABO_SLOT(programIOB4FPGA);
+        KARABO_SLOT(checkAllIOBStatus);
+
+        KARABO_SLOT(preProgSelReg);
+        KARABO_SLOT(progSelReg);
+        KARABO_SLOT(readSelReg);
+
+        KARABO_SLOT(programJTAG);
+        KARABO_SLOT(programJTAGAllModules);
+        KARABO_SLOT(programPixelRegister);
+        KARABO_SLOT(programPixelRegisterDefault);
+        KARABO_SLOT(updateSequencer);
+
+        KARABO_SLOT(doFastInit);
+        KARABO_SLOT(initChip);
+
+        KARABO_SLOT(updateStartWaitOffset);
+        KARABO_SLOT(updateSequenceCounters);
+        KARABO_SLOT(programLMKOutput);
+
+        KARABO_SLOT(resetAllBtn);
+        KARABO_SLOT(resetEPC);
+        KARABO_SLOT(resetIOBs);
+        KARABO_SLOT(resetDatapath);
+        KARABO_SLOT(resetASICs);
+        KARABO_SLOT(programEPCConfig);
+        KARABO_SLOT(readEPCRegisters);
+
+        KARABO_SLOT(setBurstParameter);
+        KARABO_SLOT(setSequencerParameter);
+        KARABO_SLOT(storePoweredPixels);
+        KARABO_SLOT(restorePoweredPixels);
+        KARABO_SLOT(setCurrentQuarterOn);
+        KARABO_SLOT(setCurrentColSkipOn);
+
+        KARABO_SLOT(setInjectionValue);
+        KARABO_SLOT(setIntDACMode);
+        KARABO_SLOT(setNormalMode);
+        KARABO_SLOT(setPixelInjectionMode);
+        KARABO_SLOT(setInjectionMode);
+
+        KARABO_SLOT(setQuadrantSetup);
+
+        KARABO_SLOT(resetAurora1);
+        KARABO_SLOT(programLMK1);
+        KARABO_SLOT(programIOB1Config);
+        KARABO_SLOT(readIOBRegisters1);
+
+        KARABO_SLOT(resetAurora2);
+        KARABO_SLOT(programLMK2);
+        KARABO_SLOT(programIOB2Config);
+        KARABO_SLOT(readIOBRegisters2);
+
+        KARABO_SLOT(resetAurora3);
+        KARABO_SLOT(programLMK3);
+        KARABO_SLOT(programIOB3Config);
+        KARABO_SLOT(readIOBRegisters3);
+
+        KARABO_SLOT(resetAurora4);
+        KARABO_SLOT(programLMK4);
+        KARABO_SLOT(programIOB4Config);
+        KARABO_SLOT(readIOBRegisters4);
+
+        KARABO_SLOT(programPLL);
+
+        KARABO_SLOT(saveConfigIOB);
+        KARABO_SLOT(saveConfiguration);
+        KARABO_SLOT(storeFullConfigFile);
+        KARABO_SLOT(storeFullConfigUnder);
+
+        KARABO_SLOT(setSendingASICs);
+        KARABO_SLOT(programLMKsAuto);
+
+        KARABO_SLOT(checkIOBDataFailed);
+        KARABO_SLOT(checkPPTDataFailed);
+        KARABO_SLOT(checkASICReset);
+        KARABO_SLOT(fillSramAndReadout);
+        KARABO_SLOT(readLastPPTTrainID);
+
+        KARABO_SLOT(waitJTAGEngineDone);
+        KARABO_SLOT(loadLastFileETHConfig);
+        KARABO_SLOT(checkQSFPConnected);
+
+        KARABO_SLOT(setThrottleDivider);
+        KARABO_SLOT(autoTuneThrottle);
+        KARABO_SLOT(applyTunedThrottle);
+
+        KARABO_SLOT(startSingleCycle);
+        
+        KARABO_SLOT(updateConfigHash);
+        KARABO_SLOT(updateConfigFromHash);
+        KARABO_SLOT(requestScene, Hash);
+        KARABO_SLOT(updateLockStats);
+        KARABO_SLOT(dumpPptTiming);
+        KARABO_SLOT(abortOperation);
+        KARABO_SLOT(getTelemetryHistory, unsigned int);
+        KARABO_SLOT(getSessionHistory, unsigned int);
+        KARABO_SLOT(resetLinkHealth);
+    }
+
+    void DsscPpt::preDestruction() {
+
+        if (this->getState() != State::ERROR) {
+            const string defaultConfigPath = DEFAULTCONF;
+            m_ppt->storeFullConfigFile(defaultConfigPath);
+            this->stop();
+        }
+        
+        stopPolling();
+      
+    }
+    
+    DsscPpt::~DsscPpt() {
+        m_telemetry.stop();
+        EventLoop::removeThread(16);
+    }
+
+    void DsscPpt::initialize() {
+        this->updateState(State::INIT);
+        m_accessToPptMutex.setName(getInstanceId());
+        m_telemetryMutex.setName(getInstanceId() + " telemetry");
+        m_readbackCache.setTimeToLive(std::chrono::milliseconds(get<unsigned int>("readbackCache.timeToLive")));
+        setHotReconfigPatterns(get<Hash>("hotReconfig"));
+        initTelemetry();
+        m_operation.setListener(std::bind(&DsscPpt::publishOperationProgress, this));
         this->set<string>("status", "Initializing Karabo device");
         KARABO_ON_DATA("registerConfigInput", receiveRegisterConfiguration);
 
@@ -1270,6 +2168,7 @@ namespace karabo {
 
         if (fullconfig->isGood()) {
             m_ppt = PPT_Pointer(new SuS::DSSC_PPT_API(fullconfig));
+            m_ppt->setTimingTable(&m_pptTiming);
         } else {
             delete fullconfig;
             KARABO_LOG_FRAMEWORK_ERROR << getInstanceId() << " FullConfigFile invalid";
@@ -1332,8 +2231,6 @@ namespace karabo {
 
     void DsscPpt::receiveRegisterConfiguration(const Hash& data,
                                                const InputChannel::MetaData& meta) {
-        DSSC::StateChangeKeeper keeper(this);
-
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " DsscPpt: received new configuration from " << meta.getSource();
 
         if (!data.has("regType")) {
@@ -1343,6 +2240,12 @@ namespace karabo {
 
         const string& regType = data.get<string>("regType");
 
+        // burst parameters are sequence counters, updateSequenceCounters keeps them itself
+        std::optional<HotReconfigKeeper> keeper;
+        if (regType != "burstParams") {
+            keeper.emplace(this, registerChanges(data));
+        }
+
         if (regType == "burstParams") {
             receiveBurstParams(data);
         } else if (regType == "sequencer") {
@@ -1419,14 +2322,20 @@ namespace karabo {
             }
         }
 
-        if (regType == "jtag") {
+        if (regType == "jtag" && get<bool>("jtagProgramming.deltaEnable")) {
+            programJtagDelta(module, false);
+        } else if (regType == "jtag") {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
+            m_jtagTracker.invalidate(module);
             if (moduleSetNames.size() > 1) {
                 m_ppt->programJtag();
             } else {
                 m_ppt->programJtagSingle(moduleSetNames.front());
             }
+        } else if (regType == "pixel" && get<bool>("pixelProgramming.deltaEnable")) {
+            programPixelDelta(module, false);
         } else if (regType == "pixel") {
+            m_pixelPlanner.invalidate(module);
             if (programDefault) {
                 DsscScopedLock lock(&m_accessToPptMutex, __func__);
                 m_ppt->programPixelRegsAllAtOnce();
@@ -1700,20 +2609,16 @@ namespace karabo {
 
 
     void DsscPpt::startPolling() {
-        if (m_keepPolling) return;
+        if (m_telemetry.isRunning()) return;
 
-        m_keepPolling = true;
-        m_pollThread.reset(new std::thread(std::bind(&DsscPpt::pollHardware, this)));
+        m_telemetry.start(std::bind(&DsscPpt::telemetryMode, this),
+                          std::bind(&DsscPpt::pollHardware, this, std::placeholders::_1));
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " PollThread started...";
     }
 
 
     void DsscPpt::stopPolling() {
-        m_keepPolling = false;
-        if (m_pollThread) {
-            m_pollThread->join();
-            m_pollThread.reset();
-        }
+        m_telemetry.stop();
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " PollThread joined...";
     }
 
@@ -1726,7 +2631,7 @@ namespace karabo {
 
 
     void DsscPpt::acquisitionStateOnEntry() {
-        DsscScopedLock lock(&m_accessToPptMutex, __func__);
+        DsscScopedLock lock(&m_accessToPptMutex, __func__, PptAccess::CONTROL);
         m_ppt->enableXFELControl(true);
         updateGuiPLLParameters();
         runXFEL();
@@ -1734,13 +2639,13 @@ namespace karabo {
 
 
     void DsscPpt::acquisitionStateOnExit() {
-        DsscScopedLock lock(&m_accessToPptMutex, __func__);
+        DsscScopedLock lock(&m_accessToPptMutex, __func__, PptAccess::CONTROL);
         stopAcquisition();
     }
 
 
     void DsscPpt::manualAcquisitionStateOnEntry() {
-        DsscScopedLock lock(&m_accessToPptMutex, __func__);
+        DsscScopedLock lock(&m_accessToPptMutex, __func__, PptAccess::CONTROL);
         m_ppt->enableXFELControl(false);
         updateGuiPLLParameters();
     }
@@ -1778,11 +2683,21 @@ namespace karabo {
 
         if (m_ppt->isOpen()) {
 
-            resetAll();
+            m_readbackCache.invalidateAll();
+            openTelemetryConnection();
 
-            programPLL();
+            const bool warm = get<bool>("warmReconnect") && isWarmReconnectPossible();
+            if (warm) {
+                KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Hardware state unchanged since last session, skip reset and PLL programming";
+                // bring the local register model in line with the running hardware
+                readEPCRegisters();
+            } else {
+                resetAll();
 
-            programPLLFine();
+                programPLL();
+
+                programPLLFine();
+            }
 
             readSerialNumber();
 
@@ -1790,12 +2705,87 @@ namespace karabo {
 
             checkQSFPConnected();
 
-            this->updateState(State::OFF, Hash("status", "Connected to PPT"));
+            if (!warm) {
+                saveHardwareFingerprint();
+            }
+            set<string>("connectMode", warm ? "WARM" : "COLD");
+
+            this->updateState(State::OFF, Hash("status", warm ? "Reconnected to running PPT" : "Connected to PPT"));
 
         } 
     }
 
 
+    HardwareFingerprint DsscPpt::readHardwareFingerprint() {
+        HardwareFingerprint fingerprint;
+
+        DsscScopedLock lock(&m_accessToPptMutex, __func__);
+        stringstream serial;
+        serial << hex << "0x" << m_ppt->readSerialNumber();
+        fingerprint.set("serial", serial.str());
+        fingerprint.set("firmware", m_ppt->readBuildStamp());
+        fingerprint.set("linux", m_ppt->readLinuxBuildStamp());
+
+        for (const string moduleSet : {"PLLReadbackRegister", "CLOCK_FANOUT_CONTROL", "AuroraRX_Control"}) {
+            m_ppt->readBackEPCRegister(moduleSet);
+        }
+        bool internalPLL = m_ppt->getEPCParam("PLLReadbackRegister", "0", "CLOUT_SEL");
+        bool locked = internalPLL ? m_ppt->getEPCParam("CLOCK_FANOUT_CONTROL", "0", "mmcm_locked")
+                : m_ppt->getEPCParam("PLLReadbackRegister", "0", "PLL_LD");
+        fingerprint.set("pllLocked", locked ? "1" : "0");
+        fingerprint.set("internalPLL", internalPLL ? "1" : "0");
+        fingerprint.set("xfelClock", m_ppt->getEPCParam("CLOCK_FANOUT_CONTROL", "0", "CLIN_SEL") == 0 ? "1" : "0");
+        fingerprint.set("numFramesToSend", toString(m_ppt->getEPCParam("AuroraRX_Control", "0", "num_frames_to_send")));
+
+        unsigned int activeIOBs = 0;
+        for (int iob = 1; iob <= 4; iob++) {
+            if (m_ppt->isIOBAvailable(iob)) {
+                activeIOBs |= 1 << (iob - 1);
+            }
+        }
+        fingerprint.set("activeIOBs", toString(activeIOBs));
+
+        return fingerprint;
+    }
+
+
+    string DsscPpt::fingerprintFileName() {
+        return "ConfigFiles/" + getInstanceId() + ".fingerprint";
+    }
+
+
+    void DsscPpt::saveHardwareFingerprint() {
+        if (!readHardwareFingerprint().save(fingerprintFileName())) {
+            KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " Could not store hardware fingerprint in " << fingerprintFileName();
+        }
+    }
+
+
+    bool DsscPpt::isWarmReconnectPossible() {
+        const HardwareFingerprint persisted = HardwareFingerprint::load(fingerprintFileName());
+        if (persisted.empty()) {
+            KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " No hardware fingerprint of a previous session found";
+            return false;
+        }
+
+        const HardwareFingerprint current = readHardwareFingerprint();
+        if (current.get("pllLocked") != "1" || current.get("internalPLL") != (get<bool>("pptPLL.internalPLL") ? "1" : "0")) {
+            KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " PPT PLL not locked or not configured as requested";
+            set<string>("fingerprintMismatch", "pllLocked");
+            return false;
+        }
+
+        const vector<string> differences = current.differences(persisted);
+        set<string>("fingerprintMismatch", boost::algorithm::join(differences, ","));
+        if (!differences.empty()) {
+            KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Hardware state changed since last session: "
+                    << boost::algorithm::join(differences, ",");
+            return false;
+        }
+        return true;
+    }
+
+
     void DsscPpt::runContMode(bool run) {
         State endState = run ? State::STARTED : State::ON;
         DSSC::StateChangeKeeper keeper(this, endState);
@@ -1803,7 +2793,8 @@ namespace karabo {
         set<bool>("continuous_mode", run);
         {
             KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " runContMode mutex";
-            DsscScopedLock lock(&m_accessToPptMutex, __func__);
+            DsscScopedLock lock(&m_accessToPptMutex, __func__, PptAccess::CONTROL);
+            m_readbackCache.invalidate("EPC");
             m_ppt->runContinuousMode(run);
         }
     }
@@ -1815,12 +2806,19 @@ namespace karabo {
         set<bool>("disable_sending", false);
         {
             KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " runAcquisition mutex";
-            DsscScopedLock lock(&m_accessToPptMutex, __func__);
+            DsscScopedLock lock(&m_accessToPptMutex, __func__, PptAccess::CONTROL);
+            m_readbackCache.invalidate("EPC");
             m_ppt->disableSending(false);
         }
 
         if (run) {
+            resetStallWatchdog();
+            m_throughputMeter.reset();
+            startSession();
             startPolling();
+        } else {
+            // every way of stopping the acquisition ends the session, e.g. stopStandalone
+            finishSession();
         }
     }
 
@@ -1844,104 +2842,197 @@ namespace karabo {
         runAcquisition(true);
     }
     
-    void DsscPpt::burstAcquisitionPolling() {
-        
-        try {
-            KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Hardware polling started";
-       
-          unsigned int num_trains = get<unsigned int>("numBurstTrains");
-          assert(num_trains);
+    void DsscPpt::updateBurstProgress(unsigned long long trainId, TrainIdTracker::Clock::time_point readTime, bool cycleDone) {
+        m_burstTrainIdReads++;
+
+        if (m_burstHardware) {
+            // the PPT stops by itself, only wait for the last cycle
+            if (!m_burstArmed) return;
+            m_burstCurrentTrainId = trainId;
+            if (cycleDone && trainId >= m_burstLastTrainId) {
+                m_burstDoneTrainId = trainId;
+                finishBurstAcquisition();
+                set<unsigned int>("burstData.numTrainIdReads", m_burstTrainIdReads);
+                EventLoop::post(karabo::util::bind_weak(&DsscPpt::stop, this));
+            } else if (m_trainIdTracker.isReady()) {
+                m_burstPollInterval = 250;
+                const auto endTime = m_trainIdTracker.predictArrival(m_burstLastTrainId + 1);
+                m_telemetry.scheduleAt("trainId", std::max(readTime, std::min(endTime, readTime + 5s)));
+            }
+            return;
+        }
 
-          //const auto currentState = getState();
-          
-          start();
-          
-          //updateState(State::ACQUIRING);
+        m_burstCurrentTrainId = trainId;
 
-          unsigned long long last_trainId;       
-          unsigned long long first_burstTrainId;
-          {
-            //boost::mutex::scoped_lock lock(m_accessToPptMutex);
-            DsscScopedLock lock(&m_accessToPptMutex, __func__);
-            first_burstTrainId = m_ppt->getCurrentTrainID();
-          }
-        
-          set<unsigned long long>("burstData.startTrainId", 0);
-          set<unsigned long long>("burstData.endTrainId", 0);
-          bool first_train = true;
-        
-          static unsigned int wait_time = 30000;
-
-          unsigned long long current_trainId;        
-          while (m_burstAcquisition.load()) {
-              
-              {
-                  //boost::mutex::scoped_lock lock(m_accessToPptMutex);
-                  DsscScopedLock lock(&m_accessToPptMutex, __func__);
-                  current_trainId = m_ppt->getCurrentTrainID();
-              }
-
-              if(first_train){
-                  if(current_trainId != first_burstTrainId){
-                    unsigned long long elapsedTrains = current_trainId - first_burstTrainId;
-                    if( (elapsedTrains > 0) && elapsedTrains < (unsigned long long)(3) ){
-                        last_trainId = current_trainId;
-                        first_train = false;
-                    }
-                    first_burstTrainId = current_trainId;
-                  }
-                  usleep(wait_time);
-                  continue;
-              }
-
-
-              if(current_trainId > last_trainId){
-                  unsigned long long train_diff = current_trainId - first_burstTrainId;
-                  if(train_diff >= num_trains){
-                      std::cout << "stopped acquisition, current/first trainId: " << current_trainId << "  " << first_burstTrainId << std::endl;
-                      m_burstAcquisition.store(false); 
-                      set<unsigned long long>("burstData.startTrainId", first_burstTrainId);
-                      set<unsigned long long>("burstData.endTrainId", current_trainId);
-                      stop();
-                  }else{
-                      last_trainId = current_trainId;
-                      if(train_diff > 10){
-                          wait_time = 250000;// to prevent often hw polling
-                      }else{
-                          wait_time = 30000;
-                      }
-                  }
-              }else{
-                 if(current_trainId < first_burstTrainId){
-                   std::cout << "current_trainId is less than first_burstTrainId: " << current_trainId << "  " << first_burstTrainId << std::endl; 
-                 }
-              }
-              usleep(wait_time);
-          }
-        
-          set<unsigned long long>("burstData.startTrainId", first_burstTrainId);
-          set<unsigned long long>("burstData.endTrainId", current_trainId);
-          
-          //updateState(currentState);
-          //updateState(State::ON);
-         
-        } catch (const Exception& e) {
-            KARABO_LOG_FRAMEWORK_ERROR << getInstanceId() << e;
-        } catch (...) {
-            KARABO_LOG_FRAMEWORK_ERROR << getInstanceId() << " Unknown exception was raised in poll thread";
+        // wait until the train id advances regularly before counting trains
+        if (m_burstFirstTrain) {
+            if (m_burstFirstTrainId == 0) {
+                m_burstFirstTrainId = trainId;
+            } else if (trainId != m_burstFirstTrainId) {
+                unsigned long long elapsedTrains = trainId - m_burstFirstTrainId;
+                if ((elapsedTrains > 0) && elapsedTrains < (unsigned long long) (3)) {
+                    m_burstLastTrainId = trainId;
+                    m_burstFirstTrain = false;
+                }
+                m_burstFirstTrainId = trainId;
+            }
+            return;
+        }
+
+        if (trainId > m_burstLastTrainId) {
+            unsigned long long train_diff = trainId - m_burstFirstTrainId;
+            const unsigned int numBurstTrains = get<unsigned int>("numBurstTrains");
+            if (train_diff >= numBurstTrains) {
+                std::cout << "stopped acquisition, current/first trainId: " << trainId << "  " << m_burstFirstTrainId << std::endl;
+                m_burstDoneTrainId = trainId;
+                finishBurstAcquisition();
+                set<unsigned int>("burstData.numTrainIdReads", m_burstTrainIdReads);
+                // stop from the event loop, the telemetry thread must not wait for itself
+                EventLoop::post(karabo::util::bind_weak(&DsscPpt::stop, this));
+                return;
+            }
+            m_burstLastTrainId = trainId;
+        } else if (trainId < m_burstFirstTrainId) {
+            std::cout << "current_trainId is less than first_burstTrainId: " << trainId << "  " << m_burstFirstTrainId << std::endl;
+        }
+
+        // Sleep until shortly before the predicted end of the burst and poll
+        // from there on. Long bursts are checked every 5 s, a read not
+        // matching the prediction resets the tracker and polling finds
+        // new train edges.
+        const unsigned long long endTrainId = m_burstFirstTrainId + get<unsigned int>("numBurstTrains");
+        m_burstPollInterval = 30;
+        if (m_trainIdTracker.isReady() && endTrainId > trainId + 1) {
+            const auto endTime = m_trainIdTracker.predictArrival(endTrainId) - 50ms;
+            m_telemetry.scheduleAt("trainId", std::max(readTime, std::min(endTime, readTime + 5s)));
+        }
+    }
+
+
+    void DsscPpt::finishBurstAcquisition() {
+        if (m_burstAcquisition.exchange(false)) {
+            // the PPT does not report the trains of its cycles, only the trains armed for are known
+            const bool planned = m_burstHardware && m_burstArmed;
+            const unsigned long long first = m_burstFirstTrainId;
+            const unsigned long long last = planned ? m_burstLastTrainId.load() : m_burstCurrentTrainId.load();
+            Hash h;
+            h.set<unsigned long long>("burstData.startTrainId", first);
+            h.set<unsigned long long>("burstData.endTrainId", last);
+            h.set<unsigned int>("burstData.numTrains", (last >= first && first > 0) ? last - first + 1 : 0);
+            h.set<bool>("burstData.planned", planned);
+            h.set<unsigned long long>("burstData.doneTrainId", m_burstDoneTrainId);
+            this->set(h);
+        }
+    }
+
+
+    bool DsscPpt::isHardwareBurstSupported() {
+        // build stamps of the same format compare by their text
+        const string minFirmware = get<string>("burstHardwareMinFirmware");
+        const string firmware = get<string>("firmwareRev");
+        return !minFirmware.empty() && firmware != "nA" && firmware >= minFirmware;
+    }
+
+
+    bool DsscPpt::armHardwareBurst(unsigned int numTrains) {
+        // iterations is a 16 bit counter
+        if (numTrains > 0xFFFF) return false;
+
+        const vector<string> signals{"iterations", "slow_mode", "continuous_mode", "disable_sending", "doSingleCycle"};
+        DsscScopedLock lock(&m_accessToPptMutex, __func__, PptAccess::CONTROL);
+        m_readbackCache.invalidate("EPC/Single_Cycle_Register");
+        vector<uint32_t> previous;
+        for (const auto & signal : signals) {
+            previous.push_back(m_ppt->getEPCParam("Single_Cycle_Register", "0", signal));
+        }
+        m_ppt->setEPCParam("Single_Cycle_Register", "all", "iterations", numTrains);
+        m_ppt->setEPCParam("Single_Cycle_Register", "all", "slow_mode", 0);
+        m_ppt->setEPCParam("Single_Cycle_Register", "all", "continuous_mode", 0);
+        m_ppt->setEPCParam("Single_Cycle_Register", "all", "disable_sending", 0);
+        m_ppt->setEPCParam("Single_Cycle_Register", "all", "doSingleCycle", 0);
+        m_ppt->programEPCRegister("Single_Cycle_Register");
+
+        m_ppt->readBackEPCRegister("Single_Cycle_Register");
+        if (m_ppt->getEPCParam("Single_Cycle_Register", "0", "iterations") != numTrains) {
+            // leave the register as it was before
+            for (size_t i = 0; i < signals.size(); i++) {
+                m_ppt->setEPCParam("Single_Cycle_Register", "all", signals[i], previous[i]);
+            }
+            m_ppt->programEPCRegister("Single_Cycle_Register");
+            return false;
+        }
+
+        m_ppt->setEPCParam("Single_Cycle_Register", "all", "doSingleCycle", 1);
+        m_ppt->programEPCRegister("Single_Cycle_Register");
+        const unsigned long long trainId = m_ppt->getCurrentTrainID();
+        m_ppt->setEPCParam("Single_Cycle_Register", "all", "doSingleCycle", 0);
+        m_ppt->programEPCRegister("Single_Cycle_Register");
+
+        // the first cycle is sent with the next train
+        m_burstFirstTrainId = trainId + 1;
+        m_burstLastTrainId = trainId + numTrains;
+        m_burstCurrentTrainId = trainId;
+        m_burstArmed = true;
+        return true;
+    }
+
+
+    void DsscPpt::startHardwareBurst() {
+        if (isHardwareBurstSupported()) {
+            // sending is enabled before the cycles are started, nothing is sent without them
+            runAcquisition(true);
+            if (armHardwareBurst(get<unsigned int>("numBurstTrains"))) {
+                KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Armed burst of trains " << m_burstFirstTrainId
+                        << " to " << m_burstLastTrainId;
+                set<string>("burstData.mode", "HARDWARE");
+                m_telemetry.wakeUp();
+                return;
+            }
         }
+
+        KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " PPT can not count the burst trains, using SOFTWARE burst mode";
+        m_burstHardware = false;
+        set<string>("burstData.mode", "SOFTWARE");
+        start();
     }
 
 
     void DsscPpt::startBurstAcquisition() {
-       
+        set<unsigned long long>("burstData.startTrainId", 0);
+        set<unsigned long long>("burstData.endTrainId", 0);
+        m_burstFirstTrainId = 0;
+        m_burstLastTrainId = 0;
+        m_burstCurrentTrainId = 0;
+        m_burstDoneTrainId = 0;
+        m_burstFirstTrain = true;
+        m_burstPollInterval = 30;
+        m_burstTrainIdReads = 0;
+        m_burstHardware = (get<string>("burstMode") == "HARDWARE");
+        m_burstArmed = false;
+        Hash h;
+        h.set<unsigned int>("burstData.numTrains", 0);
+        h.set<unsigned int>("burstData.numTrainIdReads", 0);
+        h.set<bool>("burstData.planned", false);
+        h.set<unsigned long long>("burstData.doneTrainId", 0);
+        h.set("burstData.mode", m_burstHardware ? string("HARDWARE") : string("SOFTWARE"));
+        this->set(h);
+
+        // the acquisition runs before the trains are counted, so no train of the burst is missed
+        if (m_burstHardware) {
+            startHardwareBurst();
+        } else {
+            start();
+        }
         m_burstAcquisition.store(true);
-        EventLoop::post(karabo::util::bind_weak(&DsscPpt::burstAcquisitionPolling, this));       
-   }
+
+        // train ids are read by the telemetry thread
+        startPolling();
+        m_telemetry.wakeUp();
+    }
     
     void DsscPpt::stopAcquisition() {
         
-        m_burstAcquisition.store(false);
+        finishBurstAcquisition();
 
         runAcquisition(false);
         if (m_ppt->isXFELMode()){
@@ -1951,7 +3042,7 @@ namespace karabo {
         // Disable the acquisition of sim data if enabled, as it will otherwise
         // remain active in subsequent acquisitions.
         if(this->get<bool>("send_dummy_dr_data")) {
-            DsscScopedLock lock(&m_accessToPptMutex, __func__);
+            DsscScopedLock lock(&m_accessToPptMutex, __func__, PptAccess::CONTROL);
             m_ppt->enableDummyDRData(false);
         }
 
@@ -1998,6 +3089,7 @@ namespace karabo {
             uint16_t asics = 1 << (15 - 11 + 8);
             m_ppt->setActiveAsics(asics);
             m_ppt->setPRBPowerSelect("3", false);
+            invalidateAsicState();
 
             startManualMode();
             if (get<string>("qsfp.chan1.recv.macaddr") == "00:1b:21:55:1f:c9" ||
@@ -2078,6 +3170,7 @@ namespace karabo {
         {            
           ContModeKeeper keeper(this);
           m_ppt->loadFullConfig(fileName, false);
+          invalidateAsicState();
           string defaultConfigPath = DEFAULTCONF;
           m_ppt->storeFullConfigFile(defaultConfigPath);
           //updateSequenceCounters();
@@ -2269,51 +3362,108 @@ namespace karabo {
         if(diff_entries.empty()) std::cout << "No changes in config found" << std::endl;
         
         karabo::data::Schema theschema = this->getFullSchema();
-        for(auto it : diff_entries){
+        std::vector<HotReconfigPolicy::Change> changes;
+        for (const auto & it : diff_entries) {
             auto SplitVec = splitKey(it.first);
-           
-            std::string selModSet = theschema.getDisplayedName(s_dsscConfBaseNode + "." \
-                    + SplitVec[0]+"."+SplitVec[1]);
-            std::string sigName = theschema.getDisplayedName(s_dsscConfBaseNode + "." + \
-                    SplitVec[0]+"."+SplitVec[1]+ "."+SplitVec[2]);
-            
-            
-            SuS::ConfigReg* configRegister;
+            const std::string prefix = it.first.substr(0,4);
+            const std::string regType = (prefix == "EPCR") ? "EPC" : (prefix == "IOBR") ? "IOB" : (prefix == "Jtag") ? "JTAG" : prefix;
+            changes.push_back({regType,
+                               theschema.getDisplayedName(s_dsscConfBaseNode + "." + SplitVec[0] + "." + SplitVec[1]),
+                               theschema.getDisplayedName(s_dsscConfBaseNode + "." + SplitVec[0] + "." + SplitVec[1] + "." + SplitVec[2])});
+        }
+        // registers which are not safe between trains are written immediately with the device CHANGING
+        std::optional<HotReconfigKeeper> keeper;
+        if (!diff_entries.empty()) {
+            keeper.emplace(this, changes);
+        }
+
+        // collect the values per module set first, then apply and program every affected module set once
+        struct Target {
+
+            std::string regType;
+            uint32_t module;
+            std::string moduleSet;
+
+            bool operator<(const Target & other) const {
+                return std::tie(regType, module, moduleSet) < std::tie(other.regType, other.module, other.moduleSet);
+            }
+        };
+        struct Value {
+
+            std::string modules;
+            std::string signal;
+            unsigned int value;
+        };
+        std::vector<Target> targets;
+        std::map<Target, std::vector<Value>> values;
+        for (size_t i = 0; i < diff_entries.size(); i++) {
+            const auto & it = diff_entries[i];
+            auto SplitVec = splitKey(it.first);
+            const std::string & selModSet = changes[i].moduleSet;
+            const std::string & sigName = changes[i].signal;
+
             KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " " << selModSet + "\t" +  SplitVec.back() + "\t" + sigName + " :\t" << it.second;
             try{
-                if(it.first.substr(0,4) == "EPCR"){
-                    configRegister =  m_ppt->getRegisters("epc");
-                    configRegister->setSignalValue(selModSet, SplitVec.back(), sigName, it.second);
-                    {
-                        DsscScopedLock lock(&m_accessToPptMutex, __func__);
-                        m_ppt->programEPCRegister(selModSet);
-                    }
-                }else if(it.first.substr(0,4) == "IOBR"){
-                    configRegister =  m_ppt->getRegisters("iob");
-                    configRegister->setSignalValue(selModSet, SplitVec.back(), sigName, it.second);
-                    const uint32_t module = get<uint32_t>("selModule");
-                    setActiveModule(module);
-                    {
-                        DsscScopedLock lock(&m_accessToPptMutex, __func__);
-                        m_ppt->programIOBRegister(selModSet);
-                    }
-                }else if(it.first.substr(0,4) == "Jtag"){
-                    configRegister =  m_ppt->getRegisters("jtag");
-                    uint32_t module = std::stoul(SplitVec[0].substr(SplitVec[0].length()-1, SplitVec[0].length()-1));
-                    setActiveModule(module);
-                    configRegister->setSignalValue(selModSet, SplitVec.back(), sigName, it.second);                
-                    {
-                        DsscScopedLock lock(&m_accessToPptMutex, __func__);
-                        m_ppt->programJtagSingle(selModSet);
-                    }                
-                }else{
+                Target target{changes[i].regType, 0, selModSet};
+                if(target.regType == "IOB"){
+                    target.module = get<uint32_t>("selModule");
+                }else if(target.regType == "JTAG"){
+                    target.module = std::stoul(SplitVec[0].substr(SplitVec[0].length()-1, SplitVec[0].length()-1));
+                }else if(target.regType != "EPC"){
                     KARABO_LOG_FRAMEWORK_DEBUG << getInstanceId() << " registry is not EPC, IOB, or Jtag";
+                    continue;
                 }
+                // check_iob takes the PPT lock, so modules are checked before any value is applied
+                if (target.module > 0 && !check_iob(target.module)) continue;
+                auto & targetValues = values[target];
+                if (targetValues.empty()) targets.push_back(target);
+                targetValues.push_back({SplitVec.back(), sigName, it.second});
             }catch (std::logic_error){                
             }
-
-
         }
+        // the xor module sets are recalculated while programming the others
+        std::stable_partition(targets.begin(), targets.end(), [](const Target & target) {
+            return target.regType != "JTAG" || target.moduleSet.compare(0, 3, "Xor") != 0;
+        });
+
+        // values are applied to the register model under the lock used to program them, one lock for the whole
+        // update unless it is written hot in the train gaps
+        const bool hot = keeper && keeper->isHot();
+        std::optional<DsscScopedLock> lock;
+        for (const auto & target : targets) {
+            if (hot) {
+                // waiting for a gap between the trains must not block the PPT
+                lock.reset();
+                keeper->nextWrite();
+            }
+            if (!lock) lock.emplace(&m_accessToPptMutex, __func__);
+            ActiveModuleKeeper moduleKeeper(m_ppt.get(), target.module);
+            try{
+                const std::string reg = (target.regType == "EPC") ? "epc" : (target.regType == "IOB") ? "iob" : "jtag";
+                for (const auto & value : values[target]) {
+                    m_ppt->getRegisters(reg)->setSignalValue(target.moduleSet, value.modules, value.signal, value.value);
+                }
+                if(target.regType == "EPC"){
+                    m_readbackCache.invalidate("EPC/" + target.moduleSet);
+                    m_ppt->programEPCRegister(target.moduleSet);
+                }else if(target.regType == "IOB"){
+                    m_readbackCache.invalidate("IOB" + toString(target.module));
+                    m_ppt->programIOBRegister(target.moduleSet);
+                }else{
+                    m_ppt->programJtagSingle(target.moduleSet);
+                    m_jtagTracker.invalidate(target.module, target.moduleSet);
+                }
+            }catch (std::logic_error){
+            }
+        }
+        lock.reset();
+
+        Hash h;
+        h.set<unsigned int>("configUpdate.lastChanges", diff_entries.size());
+        h.set<unsigned int>("configUpdate.lastProgramOperations", targets.size());
+        this->set(h);
+        KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Applied " << diff_entries.size() << " configuration changes with "
+                << targets.size() << " program operations";
         m_last_config_hash = read_config_hash;               
     }
     
@@ -2323,6 +3473,8 @@ namespace karabo {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
             m_ppt->enablePRBStaticVoltage(false);
             m_ppt->fastASICInitTestSystem();
+            m_readbackCache.invalidateAll();
+            invalidateAsicState();
         }
 
         if (!printPPTErrorMessages()) {
@@ -2343,6 +3495,10 @@ namespace karabo {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
 
             int rc = m_ppt->initSingleModule(currentModule);
+
+            m_readbackCache.invalidateAll();
+
+            invalidateAsicState(currentModule);
             if (rc != SuS::DSSC_PPT::ERROR_OK) {
                 printPPTErrorMessages();
             }
@@ -2359,7 +3515,28 @@ namespace karabo {
     }
     
     void DsscPpt::initSystem_impl(){
-        DSSC::StateChangeKeeper keeper(this, State::ON);        
+        // an aborted init leaves the detector partially initialized, so it must not end in ON
+        this->updateState(State::CHANGING);
+        bool finished = false;
+        try {
+            finished = initSystemSteps();
+        } catch (const std::exception& e) {
+            KARABO_LOG_FRAMEWORK_ERROR << getInstanceId() << " initSystem failed: " << e.what();
+            this->updateState(State::ERROR);
+            return;
+        }
+        if (!finished) {
+            KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " initSystem aborted, detector state unknown";
+            this->set<string>("status", "Detector initialization aborted");
+        }
+        this->updateState(finished ? State::ON : State::UNKNOWN);
+    }
+
+
+    bool DsscPpt::initSystemSteps(){
+        ScopedOperation operation(m_operation, "initSystem", 5);
+
+        if (!operation.nextStep("resetAll")) return false;
         std::cout << "initSystem->resetAll()" << std::endl;
         try{
             resetAll();
@@ -2368,6 +3545,7 @@ namespace karabo {
                   << e.what() << std::endl;
         }
 
+        if (!operation.nextStep("programPLL")) return false;
         std::cout << "initSystem->programPLL()" << std::endl;
         try{
           programPLL();
@@ -2377,12 +3555,13 @@ namespace karabo {
         }
 
 
+        if (!operation.nextStep("programIOBFPGAs")) return false;
         if (checkAllIOBStatus() == 0) {
             KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " No IOBs detected. Will try to program IOB FPGAs";
             this->set<bool>("iobProgrammed", false);
             std::cout << "initSystem->programAllIOBFPGAs()" <<std::endl;
             try{
-                programAllIOBFPGAs();
+                programAllIOBFPGAs_impl();
             }catch (const std::exception& e) { // caught by reference to base
                 std::cout << "exception was caught in initSystem->programAllIOBFPGAs, with message:"
                     << e.what() << std::endl;
@@ -2391,6 +3570,7 @@ namespace karabo {
             this->set<bool>("iobProgrammed", true);
         }
 
+        if (!operation.nextStep("initChip")) return false;
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
 
@@ -2402,6 +3582,8 @@ namespace karabo {
 
             try{
                 rc = m_ppt->initSystem();
+                m_readbackCache.invalidateAll();
+                invalidateAsicState();
             }catch (const std::exception& e) { // caught by reference to base
                 std::cout << "exception was caught in initSystem->initSystem, with message:"
                      << e.what() << std::endl;
@@ -2412,12 +3594,16 @@ namespace karabo {
             }
         }
 
+        if (!operation.nextStep("updateGui")) return false;
         updateGuiRegisters();
 
         checkQSFPConnected();
 
+        saveHardwareFingerprint();
+
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << "initSystem finished";
         this->set<string>("status", "Detector initialized");
+        return true;
     }    
 
 
@@ -2428,6 +3614,7 @@ namespace karabo {
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
             m_ppt->initIOBs();
+            m_readbackCache.invalidateAll();
         }
 
         return true;
@@ -2439,6 +3626,7 @@ namespace karabo {
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
             m_ppt->initChip();
+            invalidateAsicState();
         }
 
         return printPPTErrorMessages(true);
@@ -2473,6 +3661,8 @@ namespace karabo {
 
         DsscScopedLock lock(&m_accessToPptMutex, __func__);
 
+        m_readbackCache.invalidateAll();
+        invalidateAsicState();
         m_ppt->resetAll(true);
         std::this_thread::sleep_for(1000ms);
         m_ppt->resetAll(false);
@@ -2514,6 +3704,7 @@ namespace karabo {
 
             //m_ppt->setASICReset(true); this is wrong // ALSO CHECKS IF TEST SYSTEM IN mANNHEIM
             m_ppt->iobReset(true);
+            invalidateAsicState();
             std::this_thread::sleep_for(1000ms);
             m_ppt->iobReset(false);
             //m_ppt->setASICReset(false); this is wrong
@@ -2531,6 +3722,7 @@ namespace karabo {
             m_ppt->setASICReset(true);
             std::this_thread::sleep_for(1000ms);
             m_ppt->setASICReset(false);
+            invalidateAsicState();
             //m_ppt->iobReset(false); wrong.
         }
     }
@@ -2541,6 +3733,7 @@ namespace karabo {
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " close";
         // stop polling before closing the connection
         this->stopPolling();
+        closeTelemetryConnection();
         int rc = m_ppt->closeConnection();
         if (rc != SuS::DSSC_PPT::ERROR_OK) {
             this->updateState(State::ERROR);
@@ -2595,11 +3788,22 @@ namespace karabo {
 
 
     void DsscPpt::programAllIOBFPGAs() {
+        // Delegate the long slot call to the event loop, so that it can be aborted.
+        // Remote callers still get their reply only once the FPGAs are programmed.
+        EventLoop::post(karabo::util::bind_weak(&DsscPpt::replyWhenDone, this,
+                                                karabo::util::bind_weak(&DsscPpt::programAllIOBFPGAs_impl, this), AsyncReply(this)));
+    }
+
+
+    void DsscPpt::programAllIOBFPGAs_impl() {
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Program all available IOB FPGAs";
         DSSC::StateChangeKeeper keeper(this);
+        ScopedOperation operation(m_operation, "programAllIOBFPGAs", 5);
         for (int i = 1; i <= 4; i++) {
+            if (!operation.nextStep("programIOBFPGA" + toString(i))) return;
             programIOBFPGA(i);
         }
+        if (!operation.nextStep("initIOBs")) return;
         initIOBs();
     }
 
@@ -2620,6 +3824,7 @@ namespace karabo {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
             m_ppt->setASICReset(true); //important to minimize current consumption
             m_ppt->programIOBFPGA(iobNumber);
+            invalidateAsicState(iobNumber);
         }
     }
 
@@ -2749,6 +3954,7 @@ namespace karabo {
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Program EPC Config ";
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
+            m_readbackCache.invalidate("EPC");
             m_ppt->programEPCRegisters();
         }
 
@@ -2767,6 +3973,9 @@ namespace karabo {
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Program IOB " << toString(m_ppt->activeIOBs) << " config";
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
+            for (int iob = 1; iob <= 4; iob++) {
+                m_readbackCache.invalidate("IOB" + toString(iob));
+            }
             m_ppt->programIOBRegisters(); // includes already the readback
         }
 
@@ -2785,6 +3994,7 @@ namespace karabo {
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Program IOB Config " << iobNumber;
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
+            m_readbackCache.invalidate("IOB" + toString(iobNumber));
             m_ppt->programIOBRegister(to_string(iobNumber)); // includes already the readback
         }
 
@@ -2854,22 +4064,26 @@ namespace karabo {
         if (selRegStr.compare("epc") == 0) {
             {
                 DsscScopedLock lock(&m_accessToPptMutex, __func__);
+                m_readbackCache.invalidate("EPC/" + selModSet);
                 m_ppt->programEPCRegister(selModSet);
             }
         } else if (selRegStr.compare("iob") == 0) {
             if (setActiveModule(module)) {
                 DsscScopedLock lock(&m_accessToPptMutex, __func__);
+                m_readbackCache.invalidate("IOB" + toString(module));
                 m_ppt->programIOBRegister(selModSet);
             }
         } else if (selRegStr.compare("jtag") == 0) {
             if (setActiveModule(module)) {
                 DsscScopedLock lock(&m_accessToPptMutex, __func__);
                 m_ppt->programJtagSingle(selModSet);
+                m_jtagTracker.invalidate(module, selModSet);
             }
         } else if (selRegStr.compare("pixel") == 0) {
             if (setActiveModule(module)) {
                 DsscScopedLock lock(&m_accessToPptMutex, __func__);
                 m_ppt->programPixelRegs();
+                m_pixelPlanner.invalidate(module);
             }
         }
     }
@@ -2923,14 +4137,309 @@ namespace karabo {
             return;
         }
 
+        const bool deferred = readBack && isReadBackDeferred();
+
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Program ASIC JTAG Chain " + toString(iobNumber);
+        programJtagModule(iobNumber, readBack && !deferred);
+
+        printPPTErrorMessages(readBack && !deferred);
+
+        if (deferred) {
+            scheduleVerification("JTAG", iobNumber);
+        }
+    }
+
+
+    void DsscPpt::programJtagModule(int iobNumber, bool readBack) {
         m_ppt->setActiveModule(iobNumber);
         {
+            // an explicit programming always shifts all module sets, delta programming is for configuration changes
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
             m_ppt->programJtag(readBack);
+            m_jtagTracker.invalidate(iobNumber);
         }
+    }
 
-        printPPTErrorMessages(true);
+
+    void DsscPpt::programJTAGAllModules() {
+        // Delegate the long slot call to the event loop, so that it can be aborted between the passes.
+        // Remote callers still get their reply only once all modules are programmed.
+        EventLoop::post(karabo::util::bind_weak(&DsscPpt::replyWhenDone, this,
+                                                karabo::util::bind_weak(&DsscPpt::programJTAGAllModules_impl, this), AsyncReply(this)));
+    }
+
+
+    void DsscPpt::programJTAGAllModules_impl() {
+        DSSC::StateChangeKeeper keeper(this);
+        bool readBack = get<bool>("jtagReadBackEnable");
+        const bool deferred = readBack && isReadBackDeferred();
+
+        vector<int> iobs;
+        for (int iob : m_ppt->activeIOBs) {
+            if (checkIOBVoltageEnabled(iob)) {
+                iobs.push_back(iob);
+            } else {
+                KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " IOB " + toString(iob) + " static power not enabled!";
+            }
+        }
+        if (iobs.empty()) return;
+
+        std::map<int, std::map<string, JtagDirtyTracker::Values>> content;
+        {
+            DsscScopedLock lock(&m_accessToPptMutex, __func__);
+            for (int iob : iobs) {
+                ActiveModuleKeeper moduleKeeper(m_ppt.get(), iob);
+                content[iob] = jtagContent();
+            }
+        }
+
+        vector<vector<int>> groups;
+        if (get<bool>("broadcastProgramming.enable")) {
+            groups = BroadcastPlanner::groups(content);
+        } else {
+            for (int iob : iobs) groups.push_back({iob});
+        }
+
+        KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Program ASIC JTAG Chains " << toString(iobs) << " in "
+                << groups.size() << " passes";
+        ScopedOperation operation(m_operation, "programJTAGAllModules", groups.size());
+        unsigned int numModules = 0;
+        unsigned int numPasses = 0;
+        for (const auto & group : groups) {
+            if (!operation.nextStep("IOBs " + toString(group))) break;
+            if (group.size() > 1) {
+                // a broadcast reads back only the addressed module, every module is verified on its own
+                const bool ok = programJtagBroadcast(group, false);
+                printPPTErrorMessages();
+                numPasses++;
+                if (ok) {
+                    if (readBack) {
+                        for (int iob : group) {
+                            if (deferred) {
+                                scheduleVerification("JTAG", iob);
+                            } else {
+                                verifyModule("JTAG", iob);
+                            }
+                        }
+                    }
+                    numModules += group.size();
+                    continue;
+                }
+                KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " JTAG broadcast to IOBs " << toString(group)
+                        << " failed, programming them one by one";
+            }
+            for (int iob : group) {
+                programJtagModule(iob, readBack && !deferred);
+                printPPTErrorMessages(readBack && !deferred);
+                if (deferred) {
+                    scheduleVerification("JTAG", iob);
+                }
+                numModules++;
+                numPasses++;
+            }
+        }
+        m_ppt->setActiveModule(get<uint32_t>("activeModule"));
+
+        m_broadcastPlanner.addProgramming(numModules, numPasses);
+        Hash h;
+        h.set("broadcastProgramming.lastModules", numModules);
+        h.set("broadcastProgramming.lastPasses", numPasses);
+        h.set("broadcastProgramming.modulesProgrammed", m_broadcastPlanner.modulesProgrammed());
+        h.set("broadcastProgramming.passes", m_broadcastPlanner.passes());
+        this->set(h);
+    }
+
+
+    bool DsscPpt::programJtagBroadcast(const std::vector<int> & iobs, bool readBack) {
+        const string engineReg = "JTAG_Control_Register";
+        const uint32_t mask = BroadcastPlanner::engineMask(iobs);
+        const int addressed = iobs.front();
+
+        bool ok = false;
+        DsscScopedLock lock(&m_accessToPptMutex, __func__);
+        ScopedLatencyTimer timer(m_pptTiming, "programJtagBroadcast");
+        m_ppt->setActiveModule(addressed);
+
+        std::array<uint32_t, 4> enables;
+        for (int iob = 1; iob <= 4; ++iob) {
+            enables[iob - 1] = m_ppt->getEPCParam(engineReg, "0", "EnJTAG" + toString(iob));
+        }
+        const auto restoreEnables = [&]() {
+            for (int iob = 1; iob <= 4; ++iob) {
+                m_ppt->setEPCParam(engineReg, "0", "EnJTAG" + toString(iob), enables[iob - 1]);
+            }
+            m_readbackCache.invalidate("EPC/" + engineReg);
+            m_ppt->programEPCRegister(engineReg);
+        };
+
+        // all module sets are shifted, as by the explicit programming of a single module
+        for (int iob : iobs) m_jtagTracker.invalidate(iob);
+        const size_t numErrors = m_ppt->errorMessages.size();
+        try {
+            for (int iob = 1; iob <= 4; ++iob) {
+                m_ppt->setEPCParam(engineReg, "0", "EnJTAG" + toString(iob), (mask >> (iob - 1)) & 1);
+            }
+            m_readbackCache.invalidate("EPC/" + engineReg);
+            m_ppt->programEPCRegister(engineReg);
+            ok = m_ppt->programJtag(readBack);
+        } catch (...) {
+            restoreEnables();
+            throw;
+        }
+        restoreEnables();
+        ok = ok && m_ppt->errorMessages.size() == numErrors;
+
+        KARABO_LOG_FRAMEWORK_DEBUG << getInstanceId() << " JTAG broadcast to IOBs " << toString(iobs)
+                << (ok ? " done" : " failed");
+        return ok;
+    }
+
+
+    std::vector<std::string> DsscPpt::jtagModuleSets() {
+        auto * jtagRegisters = m_ppt->getJTAGRegisters();
+        vector<string> moduleSets;
+        vector<string> xorSets;
+        for (const auto & moduleSet : jtagRegisters->getModuleSetNames()) {
+            if (jtagRegisters->isModuleSetReadOnly(moduleSet)) continue;
+            // the xor module sets are recalculated while programming the others
+            (moduleSet.compare(0, 3, "Xor") == 0 ? xorSets : moduleSets).push_back(moduleSet);
+        }
+        moduleSets.insert(moduleSets.end(), xorSets.begin(), xorSets.end());
+        return moduleSets;
+    }
+
+
+    std::map<std::string, JtagDirtyTracker::Values> DsscPpt::jtagContent() {
+        auto * jtagRegisters = m_ppt->getJTAGRegisters();
+        std::map<string, JtagDirtyTracker::Values> res;
+        for (const auto & moduleSet : jtagModuleSets()) {
+            auto & values = res[moduleSet];
+            for (const auto & signalName : jtagRegisters->getSignalNames(moduleSet)) {
+                const auto signalValues = jtagRegisters->getSignalValues(moduleSet, "all", signalName);
+                values.insert(values.end(), signalValues.begin(), signalValues.end());
+            }
+        }
+        return res;
+    }
+
+
+    void DsscPpt::invalidateAsicState(int iobNumber) {
+        if (iobNumber > 0) {
+            m_jtagTracker.invalidate(iobNumber);
+            m_pixelPlanner.invalidate(iobNumber);
+        } else {
+            m_jtagTracker.invalidateAll();
+            m_pixelPlanner.invalidateAll();
+        }
+    }
+
+
+    bool DsscPpt::programJtagDelta(int iobNumber, bool readBack) {
+        auto * jtagRegisters = m_ppt->getJTAGRegisters();
+        const vector<string> moduleSets = jtagModuleSets();
+
+        uint64_t bitsRequested = 0;
+        uint64_t bitsShifted = 0;
+        bool ok = true;
+        {
+            DsscScopedLock lock(&m_accessToPptMutex, __func__);
+            ScopedLatencyTimer timer(m_pptTiming, "programJtagDelta");
+            m_ppt->setActiveModule(iobNumber);
+            for (const auto & moduleSet : moduleSets) {
+                JtagDirtyTracker::Values values;
+                uint64_t bitsPerModule = 0;
+                for (const auto & signalName : jtagRegisters->getSignalNames(moduleSet)) {
+                    const auto signalValues = jtagRegisters->getSignalValues(moduleSet, "all", signalName);
+                    values.insert(values.end(), signalValues.begin(), signalValues.end());
+                    bitsPerModule += std::bit_width(static_cast<uint32_t> (jtagRegisters->getMaxSignalValue(moduleSet, signalName)));
+                }
+                const uint64_t bits = bitsPerModule * jtagRegisters->getNumModules(moduleSet);
+                bitsRequested += bits;
+                if (!m_jtagTracker.isDirty(iobNumber, moduleSet, values)) continue;
+
+                bitsShifted += bits;
+                if (m_ppt->programJtagSingle(moduleSet, readBack)) {
+                    m_jtagTracker.programmed(iobNumber, moduleSet, values);
+                } else {
+                    m_jtagTracker.invalidate(iobNumber, moduleSet);
+                    ok = false;
+                }
+            }
+        }
+        m_jtagTracker.addProgramming(bitsRequested, bitsShifted);
+
+        Hash h;
+        h.set("jtagProgramming.lastBitsRequested", static_cast<unsigned long long> (bitsRequested));
+        h.set("jtagProgramming.lastBitsShifted", static_cast<unsigned long long> (bitsShifted));
+        h.set("jtagProgramming.bitsRequested", static_cast<unsigned long long> (m_jtagTracker.bitsRequested()));
+        h.set("jtagProgramming.bitsShifted", static_cast<unsigned long long> (m_jtagTracker.bitsShifted()));
+        this->set(h);
+        KARABO_LOG_FRAMEWORK_DEBUG << getInstanceId() << " JTAG delta programming of IOB " << iobNumber << ": shifted "
+                << bitsShifted << " of " << bitsRequested << " bits";
+        return ok;
+    }
+
+
+    bool DsscPpt::programPixelDelta(int iobNumber, bool readBack) {
+        const string moduleSet = "Control register";
+        auto * pixelRegisters = m_ppt->getPixelRegisters();
+        vector<vector<uint32_t>> signalValues;
+        uint32_t bitsPerPixel = 0;
+        for (const auto & signalName : pixelRegisters->getSignalNames(moduleSet)) {
+            signalValues.push_back(pixelRegisters->getSignalValues(moduleSet, "all", signalName));
+            bitsPerPixel += std::bit_width(static_cast<uint32_t> (pixelRegisters->getMaxSignalValue(moduleSet, signalName)));
+        }
+        const size_t numPixels = PixelDeltaPlanner::numPixels(signalValues);
+        m_pixelPlanner.setBitsPerPixel(bitsPerPixel);
+        m_pixelPlanner.setDirectOverheadBits(get<unsigned int>("pixelProgramming.directOverheadBits"));
+        PixelPlan plan = m_pixelPlanner.plan(iobNumber, signalValues);
+        if (readBack) {
+            // only the full stream is read back
+            plan.strategy = PixelStrategy::FULL;
+            plan.bits = numPixels * bitsPerPixel;
+        }
+
+        bool ok = true;
+        const auto start = std::chrono::steady_clock::now();
+        {
+            DsscScopedLock lock(&m_accessToPptMutex, __func__);
+            ScopedLatencyTimer timer(m_pptTiming, "programPixelDelta");
+            m_ppt->setActiveModule(iobNumber);
+            const size_t numErrors = m_ppt->errorMessages.size();
+            switch (plan.strategy) {
+                case PixelStrategy::NONE:
+                    break;
+                case PixelStrategy::FULL:
+                    ok = m_ppt->programPixelRegs(readBack);
+                    break;
+                case PixelStrategy::UNIFORM:
+                    ok = m_ppt->programPixelRegsAllAtOnce(false);
+                    break;
+                case PixelStrategy::DIRECT:
+                    for (const auto px : plan.pixels) {
+                        m_ppt->programPixelRegDirectly(px);
+                    }
+                    break;
+            }
+            ok = ok && m_ppt->errorMessages.size() == numErrors;
+        }
+        const double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (ok) {
+            m_pixelPlanner.programmed(iobNumber, signalValues);
+        } else {
+            m_pixelPlanner.invalidate(iobNumber);
+        }
+
+        Hash h;
+        h.set("pixelProgramming.lastStrategy", pixelStrategyName(plan.strategy));
+        h.set<unsigned int>("pixelProgramming.lastChangedPixels", plan.pixels.size());
+        h.set("pixelProgramming.lastBits", static_cast<unsigned long long> (plan.bits));
+        h.set("pixelProgramming.lastFullBits", static_cast<unsigned long long> (numPixels * bitsPerPixel));
+        h.set("pixelProgramming.lastTime", time);
+        this->set(h);
+        KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Pixel programming of IOB " << iobNumber << ": " << pixelStrategyName(plan.strategy)
+                << ", " << plan.pixels.size() << " pixels changed, " << plan.bits << " bits in " << time << " ms";
+        return ok;
     }
 
 
@@ -2946,6 +4455,7 @@ namespace karabo {
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
             m_ppt->programPixelRegsAllAtOnce(false);
+            m_pixelPlanner.invalidate(iobNumber);
         }
 
         printPPTErrorMessages(true);
@@ -2961,15 +4471,24 @@ namespace karabo {
             return;
         }
 
+        const bool deferred = readBack && isReadBackDeferred();
+
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Program Pixel Registers at IOB " << iobNumber;
         m_ppt->setActiveModule(iobNumber);
 
-        {
+        if (get<bool>("pixelProgramming.deltaEnable")) {
+            programPixelDelta(iobNumber, readBack && !deferred);
+        } else {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
-            m_ppt->programPixelRegs(readBack);
+            m_ppt->programPixelRegs(readBack && !deferred);
+            m_pixelPlanner.invalidate(iobNumber);
         }
 
-        printPPTErrorMessages(true);
+        printPPTErrorMessages(readBack && !deferred);
+
+        if (deferred) {
+            scheduleVerification("Pixel", iobNumber);
+        }
     }
 
 
@@ -3018,14 +4537,210 @@ namespace karabo {
     
     void DsscPpt::programSequencers() {
         bool readBack = get<bool>("sequencerReadBackEnable");
+        const bool deferred = readBack && isReadBackDeferred();
 
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Program Sequencers";
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
-            m_ppt->programSequencers(readBack);
+            m_ppt->programSequencers(readBack && !deferred);
+        }
+
+        printPPTErrorMessages(readBack && !deferred);
+
+        if (deferred) {
+            scheduleVerification("Sequencer", 0);
+        }
+    }
+
+
+    bool DsscPpt::isReadBackDeferred() {
+        return get<string>("readBackMode") == "DEFERRED";
+    }
+
+
+    void DsscPpt::scheduleVerification(const std::string & target, int iobNumber) {
+        const string key = target + toString(iobNumber);
+        std::map<string, vector<uint64_t>> snapshot;
+        {
+            DsscScopedLock lock(&m_accessToPptMutex, __func__);
+            ActiveModuleKeeper moduleKeeper(m_ppt.get(), iobNumber);
+            snapshot = verificationContent(target);
+        }
+        unsigned long long generation;
+        {
+            std::lock_guard<std::mutex> lock(m_verificationMutex);
+            generation = ++m_verificationGenerations[key];
+            m_verificationSnapshots[key] = std::move(snapshot);
+            m_numPendingVerifications++;
+        }
+        publishVerificationStats();
+        EventLoop::post(karabo::util::bind_weak(&DsscPpt::runVerification, this, target, iobNumber, generation));
+    }
+
+
+    void DsscPpt::runVerification(const std::string & target, int iobNumber, unsigned long long generation) {
+        const string key = target + toString(iobNumber);
+        bool superseded;
+        std::map<string, vector<uint64_t>> snapshot;
+        {
+            std::lock_guard<std::mutex> lock(m_verificationMutex);
+            superseded = m_verificationGenerations[key] != generation;
+            if (!superseded) {
+                snapshot = m_verificationSnapshots[key];
+            }
+        }
+
+        // a newer programming of the same target schedules its own verification
+        std::map<string, bool> results;
+        vector<string> changed, cancelled;
+        if (!superseded) {
+            results = verifySnapshot(target, iobNumber, snapshot, true, changed, cancelled);
+        }
+        recordVerification(results, changed, cancelled, true);
+    }
+
+
+    bool DsscPpt::verifyModule(const std::string & target, int iobNumber) {
+        std::map<string, vector<uint64_t>> snapshot;
+        {
+            DsscScopedLock lock(&m_accessToPptMutex, __func__);
+            ActiveModuleKeeper moduleKeeper(m_ppt.get(), iobNumber);
+            snapshot = verificationContent(target);
+        }
+        vector<string> changed, cancelled;
+        const auto results = verifySnapshot(target, iobNumber, snapshot, false, changed, cancelled);
+        recordVerification(results, changed, cancelled, false);
+        return std::all_of(results.begin(), results.end(), [](const auto & result) {
+            return result.second;
+        });
+    }
+
+
+    std::map<std::string, bool> DsscPpt::verifySnapshot(const std::string & target, int iobNumber,
+                                                        const std::map<std::string, std::vector<uint64_t>> & snapshot,
+                                                        bool deferred, std::vector<std::string> & changed,
+                                                        std::vector<std::string> & cancelled) {
+        std::map<string, bool> results;
+        const string prefix = (iobNumber > 0 ? "IOB" + toString(iobNumber) + "/" : string()) + target + "/";
+        for (const auto & part : snapshot) {
+            // commands waiting for the PPT get it between the parts
+            DsscScopedLock lock(&m_accessToPptMutex, __func__, deferred ? PptAccess::TELEMETRY : PptAccess::PROGRAMMING);
+            // the readback shifts the register content in once more, it must not touch the ASICs of a running acquisition
+            const State state = getState();
+            if (deferred && (m_burstAcquisition || state == State::STARTED || state == State::ACQUIRING)) {
+                cancelled.push_back(prefix + part.first);
+                continue;
+            }
+            ScopedLatencyTimer timer(m_pptTiming, "verify");
+            ActiveModuleKeeper moduleKeeper(m_ppt.get(), iobNumber);
+            // parts whose content changed since the programming are skipped, only the content programmed is shifted
+            const auto content = verificationContent(target);
+            const auto current = content.find(part.first);
+            if (current == content.end() || current->second != part.second) {
+                changed.push_back(prefix + part.first);
+                continue;
+            }
+            if (target == "JTAG") {
+                m_ppt->programJtagSingle(part.first, true);
+            } else if (target == "Pixel") {
+                m_ppt->programPixelRegs(true);
+            } else {
+                m_ppt->programSequencers(true);
+            }
+            results[prefix + part.first] = printPPTErrorMessages();
+        }
+        return results;
+    }
+
+
+    void DsscPpt::recordVerification(const std::map<std::string, bool> & results, const std::vector<std::string> & changed,
+                                     const std::vector<std::string> & cancelled, bool deferred) {
+        if (!changed.empty()) {
+            KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " Verification skipped, content changed since programming: "
+                    << boost::algorithm::join(changed, ", ");
+        }
+        if (!cancelled.empty()) {
+            KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " Verification cancelled, acquisition running: "
+                    << boost::algorithm::join(cancelled, ", ");
+        }
+
+        vector<string> mismatches;
+        {
+            std::lock_guard<std::mutex> lock(m_verificationMutex);
+            m_numCancelledVerifications += cancelled.size();
+            for (const auto & result : results) {
+                m_numVerified++;
+                if (result.second) {
+                    m_verificationMismatches.erase(result.first);
+                } else {
+                    m_numMismatches++;
+                    m_verificationMismatches.insert(result.first);
+                    mismatches.push_back(result.first);
+                }
+            }
+            if (deferred) m_numPendingVerifications--;
+        }
+
+        if (!mismatches.empty()) {
+            KARABO_LOG_FRAMEWORK_ERROR << getInstanceId() << " Verification failed for "
+                    << boost::algorithm::join(mismatches, ", ");
         }
+        publishVerificationStats();
+    }
+
 
-        printPPTErrorMessages(true);    
+    std::map<std::string, std::vector<uint64_t>> DsscPpt::verificationContent(const std::string & target) {
+        std::map<string, vector<uint64_t>> res;
+        if (target == "JTAG") {
+            for (const auto & moduleSet : jtagContent()) {
+                res[moduleSet.first].assign(moduleSet.second.begin(), moduleSet.second.end());
+            }
+        } else if (target == "Pixel") {
+            const string moduleSet = "Control register";
+            auto * pixelRegisters = m_ppt->getPixelRegisters();
+            vector<vector<uint32_t>> signalValues;
+            for (const auto & signalName : pixelRegisters->getSignalNames(moduleSet)) {
+                signalValues.push_back(pixelRegisters->getSignalValues(moduleSet, "all", signalName));
+            }
+            res[moduleSet] = PixelDeltaPlanner::fingerprints(signalValues);
+        } else {
+            const auto seq = m_ppt->getSequencer();
+            auto & values = res["all"];
+            const auto add = [&values](auto value) {
+                values.push_back(static_cast<uint64_t> (value));
+            };
+            add(seq->mode);
+            add(seq->getCycleLength());
+            add(seq->integrationLength);
+            add(seq->flattopLength);
+            add(seq->rampLength);
+            add(seq->resetLength);
+            add(seq->resetIntegOffset);
+            add(seq->resetHoldLength);
+            add(seq->flattopHoldLength);
+            add(seq->rampIntegOffset);
+            add(seq->backFlipAtReset);
+            add(seq->backFlipToResetOffset);
+            add(seq->singleCapLoadLength);
+            add(seq->injectRisingEdgeOffset);
+            add(seq->emptyInjectCycles);
+            add(seq->singleSHCapMode);
+        }
+        return res;
+    }
+
+
+    void DsscPpt::publishVerificationStats() {
+        Hash h;
+        {
+            std::lock_guard<std::mutex> lock(m_verificationMutex);
+            h.set("verification.pending", m_numPendingVerifications);
+            h.set("verification.numVerified", m_numVerified);
+            h.set("verification.numMismatches", m_numMismatches);
+            h.set("verification.numCancelled", m_numCancelledVerifications);
+            h.set("verification.mismatches", vector<string>(m_verificationMismatches.begin(), m_verificationMismatches.end()));
+        }
+        this->set(h);
     }
 
     bool DsscPpt::readbackConfigIOB(int iobNumber) {
@@ -3035,12 +4750,22 @@ namespace karabo {
 
         int rc;
 
+        const string cacheKey = "IOB" + toString(iobNumber);
+        if (m_readbackCache.lookup(cacheKey)) {
+            updateReadbackCacheStats();
+            return true;
+        }
+
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Readback IOB " + toString(iobNumber) + " Config Registers";
         m_ppt->setActiveModule(iobNumber);
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
             rc = m_ppt->readBackIOBRegister();
         }
+        if (rc == SuS::DSSC_PPT::ERROR_OK) {
+            m_readbackCache.update(cacheKey);
+        }
+        updateReadbackCacheStats();
 
         printPPTErrorMessages(true);
 
@@ -3103,6 +4828,192 @@ namespace karabo {
     }
 
 
+    bool DsscPpt::sampleLinkHealth() {
+        // readout failures and aurora status of the IOBs in turn
+        int iob = 0;
+        bool aurora = false;
+        uint16_t failures = 0;
+        bool ready = false;
+        const bool ok = readModuleTelemetry(__func__, 1000ms, [&](SuS::DSSC_PPT_API & ppt) {
+            const auto iobs = ppt.activeIOBs;
+            if (iobs.empty()) return;
+            const size_t index = m_linkHealthIndex++ % (2 * iobs.size());
+            iob = iobs[index / 2];
+            aurora = (index % 2 == 1);
+            ppt.setActiveModule(iob);
+            if (aurora) {
+                ready = ppt.isAuroraReady();
+            } else {
+                failures = ppt.checkIOBDataFailed();
+            }
+        });
+        if (!ok) return false;
+        if (iob == 0) return true;
+
+        const auto now = LinkHealth::Clock::now();
+        const string node = "iob" + toString(iob) + "Status.";
+        Hash h;
+        if (aurora) {
+            m_linkHealth.setAuroraReady(iob, ready);
+            h.set(node + "iob" + toString(iob) + "Ready", ready);
+        } else {
+            m_linkHealth.addSample(now, iob, failures);
+            h.set(node + "asicChannelReadoutFailure", utils::bitEnableValueToString(failures));
+            h.set(node + "linkSamples", static_cast<unsigned long long> (m_linkHealth.numSamples(iob)));
+            h.set(node + "asicFailureCounts", m_linkHealth.failureCounts(iob));
+            h.set(node + "asicFailureRate1min", m_linkHealth.failureRates(iob, LinkHealth::WINDOWS[0], now));
+            h.set(node + "asicFailureRate10min", m_linkHealth.failureRates(iob, LinkHealth::WINDOWS[1], now));
+            h.set(node + "asicFailureRate60min", m_linkHealth.failureRates(iob, LinkHealth::WINDOWS[2], now));
+        }
+        h.set("linkHealth.summary", m_linkHealth.summary(now));
+        this->set(h);
+        return true;
+    }
+
+
+    void DsscPpt::resetLinkHealth() {
+        m_linkHealth.reset();
+        const auto now = LinkHealth::Clock::now();
+        Hash h;
+        for (int iob = 1; iob <= 4; iob++) {
+            const string node = "iob" + toString(iob) + "Status.";
+            h.set(node + "linkSamples", 0ULL);
+            h.set(node + "asicFailureCounts", m_linkHealth.failureCounts(iob));
+            h.set(node + "asicFailureRate1min", m_linkHealth.failureRates(iob, LinkHealth::WINDOWS[0], now));
+            h.set(node + "asicFailureRate10min", m_linkHealth.failureRates(iob, LinkHealth::WINDOWS[1], now));
+            h.set(node + "asicFailureRate60min", m_linkHealth.failureRates(iob, LinkHealth::WINDOWS[2], now));
+        }
+        h.set("linkHealth.summary", m_linkHealth.summary(now));
+        this->set(h);
+    }
+
+
+    void DsscPpt::updateThroughput(uint32_t outputRate, const std::array<bool, ThroughputMeter::NUM_CHANNELS> & congested) {
+        const auto now = ThroughputMeter::Clock::now();
+        m_throughputMeter.setWindow(std::chrono::seconds(get<unsigned int>("qsfp.meterWindow")));
+        m_throughputMeter.setThreshold(get<double>("qsfp.deficitThreshold"));
+        m_throughputMeter.addSample(now, outputRate, congested);
+
+        // channel n sends the data of IOB n
+        const auto sendingASICs = get<string>("sendingASICs");
+        const unsigned int numSendingAsics = (sendingASICs.length() == 17)
+                ? std::popcount(static_cast<uint16_t> (utils::bitEnableStringToValue(sendingASICs))) : 16;
+        const double expectedRate = ThroughputMeter::expectedChannelRate(get<unsigned int>("numFramesToSendOut"), numSendingAsics);
+        std::array<double, ThroughputMeter::NUM_CHANNELS> expectedRates{};
+        for (int iob : m_ppt->activeIOBs) {
+            if (iob >= 1 && iob <= static_cast<int> (expectedRates.size())) expectedRates[iob - 1] = expectedRate;
+        }
+
+        // the expected rates assume 10 trains per second, the train rate is only known under XFEL control
+        const bool xfelMode = get<bool>("xfelMode");
+        const auto channels = m_throughputMeter.throughput(now, expectedRates);
+        Hash h;
+        for (size_t ch = 0; ch < channels.size(); ch++) {
+            const string node = "qsfp.chan" + toString(ch + 1) + ".";
+            h.set(node + "estimatedRate", xfelMode ? channels[ch].rate : 0.0);
+            h.set(node + "expectedRate", xfelMode ? channels[ch].expectedRate : 0.0);
+            h.set(node + "deficit", xfelMode ? channels[ch].deficit : 0.0);
+            h.set(node + "congestion", channels[ch].congestion);
+            h.set(node + "belowExpected", xfelMode && channels[ch].belowExpected);
+        }
+        const auto total = m_throughputMeter.total(now, expectedRates);
+        h.set("qsfp.expectedRate", xfelMode ? total.expectedRate : 0.0);
+        h.set("qsfp.deficit", xfelMode ? total.deficit : 0.0);
+        h.set("qsfp.belowExpected", xfelMode && total.belowExpected);
+        this->set(h);
+    }
+
+
+    void DsscPpt::resetStallWatchdog() {
+        m_stallWatchdog.setStallTime(std::chrono::milliseconds(get<unsigned int>("watchdog.stallTrains") * 100));
+        m_stallWatchdog.reset();
+        updateStallWatchdogStats();
+    }
+
+
+    void DsscPpt::checkStall(unsigned long long trainId, uint32_t outputRate, const std::map<int, uint16_t> & channelFailures) {
+        if (!isDataExpected()) {
+            // missing data is no stall, watch again from the next sample with data expected
+            m_stallWatchdog.reset();
+            updateStallWatchdogStats();
+            return;
+        }
+        const StallRecovery recovery = m_stallWatchdog.update(StallWatchdog::Clock::now(), trainId, outputRate, channelFailures);
+        if (recovery.action == StallAction::GIVE_UP) {
+            KARABO_LOG_FRAMEWORK_ERROR << getInstanceId() << " Acquisition stalled (" << recovery.reason
+                    << "), automatic recovery failed, initSystem may be required";
+        } else if (recovery.action != StallAction::NONE) {
+            KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " Acquisition stalled (" << recovery.reason << "), "
+                    << (recovery.action == StallAction::AURORA_RESET ? "reset aurora" : "re-init") << " of IOBs " << toString(recovery.iobs);
+            // recover from the event loop, the telemetry thread keeps sampling
+            EventLoop::post(karabo::util::bind_weak(&DsscPpt::recoverStall, this, recovery.action, recovery.iobs));
+        }
+        updateStallWatchdogStats();
+    }
+
+
+    void DsscPpt::recoverStall(StallAction action, const std::vector<int> & iobs) {
+        // the acquisition may have been stopped or sending disabled since the stall was detected
+        if (getState() != State::ACQUIRING || !isDataExpected()) {
+            KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Stall recovery skipped, no data expected";
+            m_stallWatchdog.reset();
+            updateStallWatchdogStats();
+            return;
+        }
+        const auto recoveryStart = std::chrono::steady_clock::now();
+        for (int iob : iobs) {
+            if (!check_iob(iob)) continue;
+
+            bool ready = false;
+            {
+                // the module is only switched on the main connection and under the lock
+                DsscScopedLock lock(&m_accessToPptMutex, __func__, PptAccess::CONTROL);
+                ActiveModuleKeeper moduleKeeper(m_ppt.get(), iob);
+                if (action == StallAction::REINIT_MODULE) {
+                    int rc = m_ppt->initSingleModule(iob);
+                    m_readbackCache.invalidateAll();
+                    invalidateAsicState(iob);
+                    if (rc != SuS::DSSC_PPT::ERROR_OK) {
+                        printPPTErrorMessages();
+                    }
+                } else {
+                    m_ppt->auroraTXReset();
+                    ready = m_ppt->isAuroraReady();
+                }
+            }
+            if (action == StallAction::AURORA_RESET) {
+                set<bool>("iob" + toString(iob) + "Status.iob" + toString(iob) + "Ready", ready);
+                if (!ready) {
+                    KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " IOB " << iob << " Aurora NOT Locked after reset";
+                }
+            }
+        }
+        m_stallWatchdog.recoveryFinished(StallWatchdog::Clock::now());
+        m_sessionStats.addRecoveryTime(std::chrono::steady_clock::now() - recoveryStart);
+        updateStallWatchdogStats();
+    }
+
+
+    bool DsscPpt::isDataExpected() {
+        const auto sendingASICs = get<string>("sendingASICs");
+        const unsigned int numSendingAsics = (sendingASICs.length() == 17)
+                ? std::popcount(static_cast<uint16_t> (utils::bitEnableStringToValue(sendingASICs))) : 16;
+        return !get<bool>("disable_sending") && get<unsigned int>("numFramesToSendOut") > 0 && numSendingAsics > 0;
+    }
+
+
+    void DsscPpt::updateStallWatchdogStats() {
+        Hash h;
+        h.set("watchdog.status", m_stallWatchdog.status());
+        h.set("watchdog.numStalls", static_cast<unsigned long long> (m_stallWatchdog.numStalls()));
+        h.set("watchdog.numRecoveries", static_cast<unsigned long long> (m_stallWatchdog.numRecoveries()));
+        h.set("watchdog.numRecovered", static_cast<unsigned long long> (m_stallWatchdog.numRecovered()));
+        h.set("watchdog.numFailedRecoveries", static_cast<unsigned long long> (m_stallWatchdog.numFailedRecoveries()));
+        h.set("watchdog.lastRecoveryTime", static_cast<unsigned long long> (m_stallWatchdog.lastRecoveryTime()));
+        this->set(h);
+    }
+
+
     void DsscPpt::readLastPPTTrainID() {
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
@@ -3130,6 +5041,7 @@ namespace karabo {
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
             m_ppt->checkCorrectASICReset();
+            invalidateAsicState();
         }
         if (!checkPPTDataFailed()) {
             KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " Some ASICs are still not correctly initialized";
@@ -3171,8 +5083,12 @@ namespace karabo {
 
     void DsscPpt::fillSramAndReadout() {
         unsigned short pattern = get<unsigned short>("sramPattern");
+        // A single PPT call which can not be interrupted, only its progress is reported
+        ScopedOperation operation(m_operation, "fillSramAndReadout", 1);
+        operation.nextStep("fillSramAndReadout");
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
+            ScopedLatencyTimer timer(m_pptTiming, "fillSramAndReadout");
             m_ppt->fillSramAndReadout(pattern, true);
         }
     }
@@ -3226,19 +5142,44 @@ namespace karabo {
 
 
     void DsscPpt::updateFirmwareFlash() {
+        // Delegate the long slot call to the event loop, so that it can be aborted.
+        // Remote callers still get their reply only once the flash is written.
+        EventLoop::post(karabo::util::bind_weak(&DsscPpt::replyWhenDone, this,
+                                                karabo::util::bind_weak(&DsscPpt::updateFirmwareFlash_impl, this), AsyncReply(this)));
+    }
+
+
+    void DsscPpt::replyWhenDone(const std::function<void()> & work, const AsyncReply & reply) {
+        try {
+            work();
+        } catch (const std::exception& e) {
+            reply.error(e.what());
+            return;
+        }
+        reply();
+    }
+
+
+    void DsscPpt::updateFirmwareFlash_impl() {
         DSSC::StateChangeKeeper keeper(this);
+        ScopedOperation operation(m_operation, "updateFirmwareFlash", 4);
 
         stopPolling();
 
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Update PPT Firmware Flash, wait 20 minutes before proceeding";
         string fileName = get<string>("firmwareBinaryName");
 
+        if (!operation.nextStep("checkPPTRevision")) return;
         if (m_ppt->checkPPTRevision(fileName)) {
             //Copy File is required to guarantee correct fileName
+            if (!operation.nextStep("copyFile")) return;
             utils::fileCopy(fileName, "DSSC_PPT_TOP.bin");
 
+            if (!operation.nextStep("sendFile")) return;
             pptSendFile("DSSC_PPT_TOP.bin");
 
+            // once started, writing the flash can not be interrupted
+            if (!operation.nextStep("sendFlashFirmware")) return;
             {
                 KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Updating flash memory...please wait";
                 DsscScopedLock lock(&m_accessToPptMutex, __func__);
@@ -3322,12 +5263,23 @@ namespace karabo {
 
     void DsscPpt::readEPCRegisters() {
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " ReadBack EPC Registers";
-        {
+        if (!m_readbackCache.lookup("EPC")) {
+            {
+                DsscScopedLock lock(&m_accessToPptMutex, __func__);
+                m_ppt->readBackEPCRegisters();
+            }
+            m_readbackCache.update("EPC");
+
+            printPPTErrorMessages(true);
+        } else {
+            // the hardware updates the status registers by itself, the cached group only covers the others
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
-            m_ppt->readBackEPCRegisters();
+            for (const auto & moduleSet : m_ppt->getEPCRegisters()->getModuleSetNames()) {
+                if (!ReadbackCache::isStatusRegister(moduleSet)) continue;
+                m_ppt->readBackEPCRegister(moduleSet);
+            }
         }
-
-        printPPTErrorMessages(true);
+        updateReadbackCacheStats();
 
         getEPCParamsIntoGui();
     }
@@ -3335,11 +5287,9 @@ namespace karabo {
 
     void DsscPpt::readEPCPLLRegisters() {
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " ReadBack EPC PLL Registers";
-        {
-            DsscScopedLock lock(&m_accessToPptMutex, __func__);
-            m_ppt->readBackEPCRegister("PLLReadbackRegister");
-            m_ppt->readBackEPCRegister("CLOCK_FANOUT_CONTROL");
-        }
+        readBackEPCRegisterCached("PLLReadbackRegister");
+        readBackEPCRegisterCached("CLOCK_FANOUT_CONTROL");
+        updateReadbackCacheStats();
 
         printPPTErrorMessages(true);
 
@@ -3422,7 +5372,11 @@ namespace karabo {
         string keyName = "iob" + toString(iobNumber) + "Status.iobTemp";
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
-            set<int>(keyName, m_ppt->readIOBTemperature_TestSystem());
+            const int iobTemp = m_ppt->readIOBTemperature_TestSystem();
+            if (iobNumber >= 1 && iobNumber <= 4) {
+                m_iobTemps[iobNumber - 1] = iobTemp;
+            }
+            set<int>(keyName, iobTemp);
         }
     }
 
@@ -3756,6 +5710,8 @@ namespace karabo {
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
             rc = m_ppt->initSystem();
+            m_readbackCache.invalidateAll();
+            invalidateAsicState();
         }
         if (rc == SuS::DSSC_PPT::ERROR_IOB_NOT_FOUND) {
             KARABO_LOG_FRAMEWORK_ERROR << getInstanceId() << " No IOB Found, init IOBs before init system";
@@ -3823,57 +5779,63 @@ namespace karabo {
 
 
     void DsscPpt::setIntDACMode() {
-        DSSC::StateChangeKeeper keeper(this);
+        HotReconfigKeeper keeper(this, {{"JTAG", "Global Control Register", ""}, {"PIXEL", "Control register", ""}});
 
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Enable Internal DAC Mode";
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
             m_ppt->setIntDACMode();
+            invalidateAsicState();
         }
     }
 
 
     void DsscPpt::setNormalMode() {
-        DSSC::StateChangeKeeper keeper(this);
+        HotReconfigKeeper keeper(this, {{"JTAG", "Global Control Register", ""}, {"PIXEL", "Control register", ""}});
 
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Enable Normal Mode";
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
             m_ppt->setNormalMode();
+            invalidateAsicState();
         }
     }
 
 
     void DsscPpt::setPixelInjectionMode() {
-        DSSC::StateChangeKeeper keeper(this);
+        HotReconfigKeeper keeper(this, {{"JTAG", "Global Control Register", ""}, {"PIXEL", "Control register", ""}});
 
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Enable Pixel Injection Mode";
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
             m_ppt->setPixelInjectionMode();
+            invalidateAsicState();
         }
     }
 
 
     void DsscPpt::setInjectionMode() {
-        DSSC::StateChangeKeeper keeper(this);
+        HotReconfigKeeper keeper(this, {{"JTAG", "Global Control Register", ""}, {"PIXEL", "Control register", ""}});
 
         const string injectionModeStr = get<string>("injectionMode");
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Enable InjectionMode " << injectionModeStr;
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
             m_ppt->setInjectionMode(m_ppt->getInjectionMode(injectionModeStr));
+            invalidateAsicState();
         }
 
     }
 
 
     void DsscPpt::setInjectionValue() {
-        DSSC::StateChangeKeeper keeper(this);
+        // the injection DAC
+        HotReconfigKeeper keeper(this, {{"JTAG", "Global Control Register", "VDAC"}});
         const auto value = get<unsigned int>("injectionValue");
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
             m_ppt->setInjectionDAC(value);
+            invalidateAsicState();
         }
 
         getJTAGParamsIntoGui();
@@ -3964,7 +5926,18 @@ namespace karabo {
 
 
     void DsscPpt::updateSequenceCounters() {
-        DSSC::StateChangeKeeper keeper(this);
+        static const std::vector<string> counterKeys{"start_wait_time", "start_wait_offs", "gdps_on_time", "iprogLength",
+            "burstLength", "refpulseLength", "fet_on_time", "clr_on_time", "clr_cycle", "clrDuty", "iprog_clr_duty",
+            "iprog_clr_offset", "iprog_clr_en", "SW_PWR_ON"};
+        std::vector<HotReconfigPolicy::Change> changes;
+        for (const auto & key : counterKeys) {
+            const auto it = m_sequenceCounters.find(key);
+            if (it == m_sequenceCounters.end() || it->second != get<int>("sequence." + key)) {
+                changes.push_back({"SEQ", key, ""});
+            }
+        }
+        HotReconfigKeeper keeper(this, changes);
+
         const int start_wait_time = get<int>("sequence.start_wait_time");
         const int start_wait_offs = get<int>("sequence.start_wait_offs");
         const int gdps_on_time = get<int>("sequence.gdps_on_time");
@@ -3989,6 +5962,9 @@ namespace karabo {
                                            fet_on_time, clr_on_time, clr_cycle, clrDuty, SW_PWR_ON,
                                            iprog_clr_duty, iprog_clr_offset, iprog_clr_en, false);
             }
+            for (const auto & key : counterKeys) {
+                m_sequenceCounters[key] = get<int>("sequence." + key);
+            }
         }
 
         getIOBParamsIntoGui();
@@ -4001,6 +5977,116 @@ namespace karabo {
     }
 
 
+    bool DsscPpt::beginHotReconfig(const std::vector<HotReconfigPolicy::Change> & changes, HotReconfigPolicy::Clock::time_point & gapStart) {
+        const auto state = getState();
+        if (state != State::ACQUIRING && state != State::STARTED) return false;
+
+        const bool hot = get<bool>("hotReconfig.enable") && m_hotReconfig.classifyAll(changes) == HotReconfigPolicy::SAFE;
+        if (hot) {
+            m_hotReconfig.countHotWrite();
+        } else {
+            m_hotReconfig.countUnsafeWrite();
+        }
+        Hash h;
+        h.set("hotReconfig.numHotWrites", m_hotReconfig.numHotWrites());
+        h.set("hotReconfig.numUnsafeWrites", m_hotReconfig.numUnsafeWrites());
+        this->set(h);
+
+        if (hot) gapStart = waitForTrainGap();
+        return hot;
+    }
+
+
+    HotReconfigPolicy::Clock::time_point DsscPpt::waitForTrainGap() {
+        using Clock = HotReconfigPolicy::Clock;
+        const auto delay = std::chrono::milliseconds(get<unsigned int>("hotReconfig.trainGapDelay"));
+        const Clock::duration period(m_trainPeriod.load());
+        if (period > Clock::duration::zero()) {
+            const Clock::time_point arrival(Clock::duration(m_trainArrival.load()));
+            const auto gapStart = HotReconfigPolicy::nextTrainBoundary(arrival + delay, period, Clock::now());
+            std::this_thread::sleep_until(gapStart);
+            return gapStart;
+        }
+
+        // train clock not known yet, wait for the next train id
+        unsigned long long firstTrainId;
+        {
+            DsscScopedLock lock(&m_accessToPptMutex, __func__);
+            firstTrainId = m_ppt->getCurrentTrainID();
+        }
+        const auto timeout = Clock::now() + 200ms;
+        while (Clock::now() < timeout) {
+            std::this_thread::sleep_for(5ms);
+            DsscScopedLock lock(&m_accessToPptMutex, __func__);
+            if (m_ppt->getCurrentTrainID() != firstTrainId) break;
+        }
+        std::this_thread::sleep_for(delay);
+        return Clock::now();
+    }
+
+
+    HotReconfigPolicy::Clock::duration DsscPpt::trainPeriod() {
+        const HotReconfigPolicy::Clock::duration period(m_trainPeriod.load());
+        return (period > HotReconfigPolicy::Clock::duration::zero()) ? period : HotReconfigPolicy::DEFAULT_TRAIN_PERIOD;
+    }
+
+
+    void DsscPpt::waitForWriteGap(HotReconfigPolicy::Clock::time_point & gapStart, HotReconfigPolicy::Clock::duration writeTime) {
+        const auto delay = std::chrono::milliseconds(get<unsigned int>("hotReconfig.trainGapDelay"));
+        const auto now = HotReconfigPolicy::Clock::now();
+        const auto writeStart = HotReconfigPolicy::nextWriteStart(gapStart, delay, trainPeriod(), writeTime, now);
+        if (writeStart > now) {
+            gapStart = writeStart;
+            std::this_thread::sleep_until(writeStart);
+        }
+    }
+
+
+    void DsscPpt::endHotReconfig(HotReconfigPolicy::Clock::time_point gapStart) {
+        const auto delay = std::chrono::milliseconds(get<unsigned int>("hotReconfig.trainGapDelay"));
+        const auto now = HotReconfigPolicy::Clock::now();
+        // still within the gap the last write started in
+        if (HotReconfigPolicy::nextWriteStart(gapStart, delay, trainPeriod(), HotReconfigPolicy::Clock::duration::zero(), now) == now) return;
+
+        m_hotReconfig.countOverrun();
+        set<unsigned long long>("hotReconfig.numOverruns", m_hotReconfig.numOverruns());
+        KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " Register changes written while running did not finish before the next train";
+    }
+
+
+    std::vector<HotReconfigPolicy::Change> DsscPpt::registerChanges(const Hash & data) {
+        const string regType = boost::algorithm::to_upper_copy(data.get<string>("regType"));
+        if (!data.has("moduleSets")) return {{regType, "", ""}};
+
+        std::vector<HotReconfigPolicy::Change> res;
+        vector<string> moduleSetNames;
+        utils::split(data.get<string>("moduleSets"), ';', moduleSetNames, 0);
+        for (const auto & moduleSet : moduleSetNames) {
+            vector<string> signalNames;
+            if (data.has(moduleSet + ".signalNames")) {
+                utils::split(data.get<string>(moduleSet + ".signalNames"), ';', signalNames, 0);
+            }
+            if (signalNames.empty()) {
+                res.push_back({regType, moduleSet, ""});
+            }
+            for (const auto & signalName : signalNames) {
+                res.push_back({regType, moduleSet, signalName});
+            }
+        }
+        return res;
+    }
+
+
+    void DsscPpt::setHotReconfigPatterns(const Hash & config) {
+        static const std::map<string, string> keys{{"safeEPC", "EPC"}, {"safeIOB", "IOB"}, {"safeJTAG", "JTAG"}, {"safeSequence", "SEQ"}};
+        for (const auto & entry : keys) {
+            if (config.has(entry.first)) {
+                m_hotReconfig.setSafePatterns(entry.second, config.get<string>(entry.first));
+            }
+        }
+    }
+
+
     void DsscPpt::errorFound() {
 
     }
@@ -4008,6 +6094,16 @@ namespace karabo {
 
     void DsscPpt::preReconfigure(karabo::data::Hash & incomingReconfiguration) {
 
+        if (incomingReconfiguration.has("readbackCache.timeToLive")) {
+            m_readbackCache.setTimeToLive(std::chrono::milliseconds(incomingReconfiguration.get<unsigned int>("readbackCache.timeToLive")));
+        }
+        // most reconfigurations program registers, readbacks from before are outdated
+        m_readbackCache.invalidateAll();
+
+        if (incomingReconfiguration.has("hotReconfig")) {
+            setHotReconfigPatterns(incomingReconfiguration.get<Hash>("hotReconfig"));
+        }
+
         preReconfigureEPC(incomingReconfiguration);
 
         preReconfigureETH(incomingReconfiguration);
@@ -4155,6 +6251,7 @@ namespace karabo {
 
             {
                 DsscScopedLock lock(&m_accessToPptMutex, __func__);
+                m_readbackCache.invalidate("EPC");
                 for (size_t i = 0; i < channelsVec.size(); i++) {
                     m_ppt->programEPCRegister("10GE_Engine" + toString(channelsVec.at(i)) + "_Control");
                 }
@@ -4232,6 +6329,7 @@ namespace karabo {
                     cout << "numPreBurstVetos changed" << numVetos << endl;
                     {
                         DsscScopedLock lock(&m_accessToPptMutex, __func__);
+                        m_readbackCache.invalidate("EPC");
                         m_ppt->setBurstVetoOffset(numVetos);
                     }
                 } else if (path.compare("selEnvironment") == 0) {
@@ -4240,6 +6338,7 @@ namespace karabo {
                 } else if (path.compare("selPRBActivePowers") == 0) {
                     DsscScopedLock lock(&m_accessToPptMutex, __func__);
                     m_ppt->setPRBPowerSelect(filtered.getAs<string>(path), true);
+                    invalidateAsicState();
                 } else if (path.compare("numActiveASICs") == 0) {
                     int numASICs = filtered.getAs<int>(path);
                     DsscScopedLock lock(&m_accessToPptMutex, __func__);
@@ -4264,6 +6363,7 @@ namespace karabo {
                             KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << (enable ? " Disable Data Sending" : " Enable Data Sending");
                             bool disable = enable;
                             DsscScopedLock lock(&m_accessToPptMutex, __func__);
+                            m_readbackCache.invalidate("EPC");
                             m_ppt->disableSending(disable);
                             //  if(disable){
                             //    this->updateState(karabo::data::State::STARTED);
@@ -4275,6 +6375,7 @@ namespace karabo {
                         {
                             KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << (enable ? " Enable Continuous Mode" : " Disable Continuous Mode");
                             DsscScopedLock lock(&m_accessToPptMutex, __func__);
+                            m_readbackCache.invalidate("EPC");
                             m_ppt->runContinuousMode(enable);
                             //  m_ppt->disableSending(true);
                             //  if(enable){
@@ -4580,11 +6681,8 @@ namespace karabo {
             }
         }
         while (m_keepAcquisition) {
-            {
-                DsscScopedLock lock(&m_accessToPptMutex, __func__);
-                cout << '-';
-                cout.flush();
-            }
+            cout << '-';
+            cout.flush();
             std::this_thread::sleep_for(2000ms);
         }
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Acquisition stopped";
@@ -4609,7 +6707,7 @@ namespace karabo {
 
 
     void DsscPpt::setCurrentQuarterOn() {
-        DSSC::StateChangeKeeper keeper(this);
+        HotReconfigKeeper keeper(this, {{"JTAG", "Global FCSR 0", "MonBusSwitch"}, {"PIXEL", "Control register", ""}});
 
         static const vector<string> quarterStr{"0-3", "4-7", "8-11", "12-15", "16-19", "20-23", "24-27", "28-31", "32-35", "36-39", "40-43", "44-47", "48-51", "52-55", "56-59", "60-63"};
 
@@ -4630,7 +6728,7 @@ namespace karabo {
 
 
     void DsscPpt::setCurrentColSkipOn() {
-        DSSC::StateChangeKeeper keeper(this);
+        HotReconfigKeeper keeper(this, {{"JTAG", "Global FCSR 0", "MonBusSwitch"}, {"PIXEL", "Control register", ""}});
 
         string colString = getCurrentColSelectString();
 
@@ -4679,29 +6777,468 @@ namespace karabo {
     }
 
 
-    void DsscPpt::pollHardware() {
+    void DsscPpt::openTelemetryConnection() {
+        closeTelemetryConnection();
+        if (!get<bool>("telemetryConnection")) return;
+
+        SuS::PPTFullConfig* fullconfig = new SuS::PPTFullConfig(get<string>("fullConfigFileName"));
+        if (!fullconfig->isGood()) {
+            delete fullconfig;
+            KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " Telemetry connection not opened: FullConfigFile invalid";
+            return;
+        }
+
+        PPT_Pointer telemetryPpt(new SuS::DSSC_PPT_API(fullconfig));
+        telemetryPpt->setTimingTable(&m_pptTiming);
+        telemetryPpt->setPPTAddress(get<string>("pptHost"), get<unsigned int>("pptPort"));
+        int rc = telemetryPpt->openConnection();
+        if (rc != SuS::DSSC_PPT::ERROR_OK || !telemetryPpt->isOpen()) {
+            KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " Telemetry connection could not be opened, "
+                    << "telemetry is read via the main connection: " << telemetryPpt->errorString;
+            return;
+        }
+
+        {
+            DsscScopedLock lock(&m_telemetryMutex, __func__);
+            m_telemetryPpt = telemetryPpt;
+        }
+        set<bool>("telemetryConnected", true);
+        KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Telemetry connection opened";
+    }
+
+
+    void DsscPpt::closeTelemetryConnection() {
+        PPT_Pointer telemetryPpt;
+        {
+            DsscScopedLock lock(&m_telemetryMutex, __func__);
+            telemetryPpt.swap(m_telemetryPpt);
+        }
+        if (telemetryPpt) {
+            telemetryPpt->closeConnection();
+            set<bool>("telemetryConnected", false);
+        }
+    }
+
+
+    bool DsscPpt::readTelemetry(const std::string & origin, std::chrono::milliseconds timeout,
+                                const std::function<void(SuS::DSSC_PPT_API &)> & read) {
+        {
+            DsscScopedLock lock(&m_telemetryMutex, origin);
+            if (m_telemetryPpt) {
+                if (m_telemetryPpt->isOpen()) {
+                    read(*m_telemetryPpt);
+                    return true;
+                }
+                KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " Telemetry connection lost, falling back to the main connection";
+                m_telemetryPpt.reset();
+                set<bool>("telemetryConnected", false);
+            }
+        }
+
+        DsscScopedLock lock(&m_accessToPptMutex, origin, PptAccess::TELEMETRY, timeout);
+        if (!lock.owns()) return false;
+        read(*m_ppt);
+        return true;
+    }
+
+
+    bool DsscPpt::readModuleTelemetry(const std::string & origin, std::chrono::milliseconds timeout,
+                                      const std::function<void(SuS::DSSC_PPT_API &)> & read) {
+        DsscScopedLock lock(&m_accessToPptMutex, origin, PptAccess::TELEMETRY, timeout);
+        if (!lock.owns()) return false;
+        // a command may have selected its module before taking the lock
+        ActiveModuleKeeper moduleKeeper(m_ppt.get(), 0);
+        read(*m_ppt);
+        return true;
+    }
+
+
+    void DsscPpt::initTelemetry() {
+        m_telemetry.addMetric("pptTemp", std::bind(&DsscPpt::telemetryInterval, this, std::placeholders::_1));
+        m_telemetry.addMetric("ethOutputRate", [this](TelemetryMode mode) {
+            // no data is sent while idle
+            return (mode == TelemetryMode::IDLE) ? 0ms : telemetryInterval(mode);
+        });
+        m_telemetry.addMetric("trainId", [this](TelemetryMode) {
+            return m_burstAcquisition ? std::chrono::milliseconds(m_burstPollInterval.load()) : 0ms;
+        });
+        m_telemetry.addMetric("watchdog", [this](TelemetryMode mode) {
+            if (mode != TelemetryMode::ACQUIRING || !get<bool>("watchdog.enable")) return 0ms;
+            // several samples per stall time
+            return std::chrono::milliseconds(get<unsigned int>("watchdog.stallTrains") * 100 / 4);
+        });
+        m_telemetry.addMetric("linkHealth", [this](TelemetryMode mode) {
+            // the IOBs may be off while idle
+            return (mode == TelemetryMode::IDLE) ? 0ms : std::chrono::milliseconds(get<unsigned int>("linkHealth.interval"));
+        });
+        m_telemetry.addMetric("throughput", [this](TelemetryMode mode) {
+            return (mode == TelemetryMode::ACQUIRING) ? std::chrono::milliseconds(get<unsigned int>("qsfp.meterInterval")) : 0ms;
+        });
+        m_telemetry.addMetric("stats", [](TelemetryMode) {
+            return 5000ms;
+        });
+    }
+
+
+    TelemetryMode DsscPpt::telemetryMode() {
+        if (m_burstAcquisition) return TelemetryMode::ACQUIRING;
+
+        const State state = getState();
+        if (state == State::ACQUIRING) return TelemetryMode::ACQUIRING;
+        if (state == State::ON || state == State::STARTED || state == State::STOPPED) return TelemetryMode::ON;
+        return TelemetryMode::IDLE;
+    }
+
+
+    std::chrono::milliseconds DsscPpt::telemetryInterval(TelemetryMode mode) {
+        switch (mode) {
+            case TelemetryMode::ACQUIRING: return std::chrono::milliseconds(get<unsigned int>("telemetry.acquiringInterval"));
+            case TelemetryMode::ON: return std::chrono::milliseconds(get<unsigned int>("telemetry.onInterval"));
+            default: return std::chrono::milliseconds(get<unsigned int>("telemetry.idleInterval"));
+        }
+    }
+
+
+    void DsscPpt::recordTelemetrySample(unsigned long long trainId) {
+        TelemetrySample sample;
+        sample.timestamp = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+        sample.trainId = trainId;
+        sample.pptTemp = getAs<int>("pptTemp");
+        sample.ethOutputRate = getAs<unsigned int>("ethOutputRate");
+        for (size_t i = 0; i < sample.iobTemp.size(); i++) {
+            // read by getIOBTempIntoGui, the latest value is recorded
+            sample.iobTemp[i] = m_iobTemps[i];
+        }
+        m_telemetryHistory.push(sample);
+
+        const unsigned int downsampling = get<unsigned int>("telemetry.outputDownsampling");
+        if (downsampling > 0 && (m_telemetryHistory.numWritten() - 1) % downsampling == 0) {
+            Hash data;
+            data.set("timestamp", sample.timestamp);
+            data.set("trainId", static_cast<unsigned long long> (sample.trainId));
+            data.set("pptTemp", sample.pptTemp);
+            data.set("ethOutputRate", sample.ethOutputRate);
+            data.set("iobTemp", vector<int>(sample.iobTemp.begin(), sample.iobTemp.end()));
+            writeChannel("telemetryOutput", data);
+        }
+    }
+
+
+    void DsscPpt::getTelemetryHistory(unsigned int numSamples) {
+        vector<double> timestamps;
+        vector<unsigned long long> trainIds;
+        vector<int> pptTemps;
+        vector<unsigned int> outputRates;
+        vector<int> iobTemps;
+        for (const auto & sample : m_telemetryHistory.last(numSamples)) {
+            timestamps.push_back(sample.timestamp);
+            trainIds.push_back(sample.trainId);
+            pptTemps.push_back(sample.pptTemp);
+            outputRates.push_back(sample.ethOutputRate);
+            iobTemps.insert(iobTemps.end(), sample.iobTemp.begin(), sample.iobTemp.end());
+        }
+
+        Hash reply;
+        reply.set("timestamp", timestamps);
+        reply.set("trainId", trainIds);
+        reply.set("pptTemp", pptTemps);
+        reply.set("ethOutputRate", outputRates);
+        reply.set("iobTemp", iobTemps); // 4 values per sample
+        this->reply(reply);
+    }
+
+
+    void DsscPpt::startSession() {
+        // a session still running, i.e. never stopped by runAcquisition(false), is dropped
+        const double now = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+        m_sessionStats.start(std::chrono::steady_clock::now(), now, m_accessToPptMutex.totalWaitTime());
+    }
+
+
+    void DsscPpt::finishSession() {
+        if (!m_sessionStats.isRunning()) return;
+        const double now = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+        const auto session = m_sessionStats.stop(std::chrono::steady_clock::now(), now, m_accessToPptMutex.totalWaitTime());
+        const double efficiency = (session.trainsExpected > 0) ? 100.0 * session.trainsSeen / session.trainsExpected : 0.0;
+
+        Hash h;
+        h.set("lastSession.startTime", session.startTime);
+        h.set("lastSession.stopTime", session.stopTime);
+        h.set("lastSession.firstTrainId", static_cast<unsigned long long> (session.firstTrainId));
+        h.set("lastSession.lastTrainId", static_cast<unsigned long long> (session.lastTrainId));
+        h.set("lastSession.trainsExpected", static_cast<unsigned long long> (session.trainsExpected));
+        h.set("lastSession.trainsSeen", static_cast<unsigned long long> (session.trainsSeen));
+        h.set("lastSession.numGaps", static_cast<unsigned long long> (session.numGaps));
+        h.set("lastSession.efficiency", efficiency);
+        h.set("lastSession.meanOutputRate", session.meanOutputRate);
+        h.set("lastSession.minOutputRate", session.minOutputRate);
+        h.set("lastSession.recoveryTime", session.recoveryTime);
+        h.set("lastSession.lockWaitTime", session.lockWaitTime);
+        this->set(h);
+
+        KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Acquisition session of trains " << session.firstTrainId << " to "
+                << session.lastTrainId << ": " << session.trainsSeen << " of " << session.trainsExpected << " trains, "
+                << session.numGaps << " gaps, mean output rate " << session.meanOutputRate << " MBit/s";
+    }
+
+
+    void DsscPpt::getSessionHistory(unsigned int numSessions) {
+        vector<double> startTimes, stopTimes, meanOutputRates, minOutputRates, recoveryTimes, lockWaitTimes;
+        vector<unsigned long long> firstTrainIds, lastTrainIds, trainsExpected, trainsSeen, numGaps;
+        for (const auto & session : m_sessionStats.last(numSessions)) {
+            startTimes.push_back(session.startTime);
+            stopTimes.push_back(session.stopTime);
+            firstTrainIds.push_back(session.firstTrainId);
+            lastTrainIds.push_back(session.lastTrainId);
+            trainsExpected.push_back(session.trainsExpected);
+            trainsSeen.push_back(session.trainsSeen);
+            numGaps.push_back(session.numGaps);
+            meanOutputRates.push_back(session.meanOutputRate);
+            minOutputRates.push_back(session.minOutputRate);
+            recoveryTimes.push_back(session.recoveryTime);
+            lockWaitTimes.push_back(session.lockWaitTime);
+        }
+
+        Hash reply;
+        reply.set("startTime", startTimes);
+        reply.set("stopTime", stopTimes);
+        reply.set("firstTrainId", firstTrainIds);
+        reply.set("lastTrainId", lastTrainIds);
+        reply.set("trainsExpected", trainsExpected);
+        reply.set("trainsSeen", trainsSeen);
+        reply.set("numGaps", numGaps);
+        reply.set("meanOutputRate", meanOutputRates);
+        reply.set("minOutputRate", minOutputRates);
+        reply.set("recoveryTime", recoveryTimes);
+        reply.set("lockWaitTime", lockWaitTimes);
+        this->reply(reply);
+    }
+
+
+    bool DsscPpt::pollHardware(const std::vector<std::string> & metrics) {
+        auto due = [&metrics](const char * metric) {
+            return std::find(metrics.begin(), metrics.end(), metric) != metrics.end();
+        };
+
+        bool ok = true;
         try {
-            KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Hardware polling started";
-            while (m_keepPolling) {
-                
-                int pptTemp;
-                {
-                    DsscScopedLock lock(&m_accessToPptMutex, __func__);
-                    m_ppt->readBackEPCRegister("Eth_Output_Data_Rate");
-                    pptTemp = m_ppt->readFPGATemperature();
-                 }
+            if (due("pptTemp") || due("ethOutputRate") || due("trainId") || due("watchdog") || due("throughput")) {
+                int pptTemp = 0;
+                uint32_t outputRate = 0;
+                std::array<bool, ThroughputMeter::NUM_CHANNELS> congested{};
+                std::map<int, uint16_t> channelFailures;
+                unsigned long long trainId = 0;
+                TrainIdTracker::Clock::time_point readTime;
+                bool cycleDone = false;
+                // a sample delayed by programming or control commands is stale, skip it
+                const auto timeout = due("trainId") ? std::chrono::milliseconds(m_burstPollInterval.load()) : 1000ms;
+                ok = readTelemetry(__func__, timeout, [&](SuS::DSSC_PPT_API & ppt) {
+                    {
+                        // every sample is tagged with the train id
+                        const auto before = TrainIdTracker::Clock::now();
+                        trainId = ppt.getCurrentTrainID();
+                        readTime = before + (TrainIdTracker::Clock::now() - before) / 2;
+                    }
+                    if (due("trainId") && m_burstHardware && m_burstArmed) {
+                        ppt.readBackEPCRegister("Single_Cycle_Register");
+                        cycleDone = ppt.getEPCParam("Single_Cycle_Register", "0", "single_cycle_done");
+                    }
+                    if (due("ethOutputRate") || due("watchdog") || due("throughput")) {
+                        ppt.readBackEPCRegister("Eth_Output_Data_Rate");
+                        outputRate = ppt.getEPCParam("Eth_Output_Data_Rate", "0", "Eth_Output_Data_Rate")/(1E6/128.0);
+                    }
+                    if (due("throughput")) {
+                        ppt.readBackEPCRegister("Ethernet_ReadbackRegister1");
+                        ppt.readBackEPCRegister("Ethernet_ReadbackRegister2");
+                        for (size_t ch = 0; ch < congested.size(); ch++) {
+                            const string chan = "Chan" + toString(ch);
+                            const bool locked = ppt.getEPCParam((ch < 3) ? "Ethernet_ReadbackRegister1" : "Ethernet_ReadbackRegister2",
+                                                                "0", chan + " PCS_Block_Lock");
+                            const bool fifosFull = ppt.getEPCParam("Ethernet_ReadbackRegister2", "0",
+                                                                   "channel" + toString(ch) + "_fifos_full");
+                            congested[ch] = !locked || fifosFull;
+                        }
+                    }
+                    if (due("pptTemp")) {
+                        pptTemp = ppt.readFPGATemperature();
+                    }
+                });
+                if (ok && due("watchdog")) {
+                    // the channel failures are read per IOB, which selects the module
+                    ok = readModuleTelemetry(__func__, timeout, [&](SuS::DSSC_PPT_API & ppt) {
+                        ScopedLatencyTimer timer(m_pptTiming, "getActiveChannelFailure");
+                        const auto iobs = ppt.activeIOBs;
+                        for (int iob : iobs) {
+                            ppt.setActiveModule(iob);
+                            channelFailures[iob] = ppt.getActiveChannelFailure();
+                        }
+                    });
+                }
+
+                if (ok) {
+                    Hash h;
+                    if (due("ethOutputRate") || due("watchdog") || due("throughput")) h.set("ethOutputRate", outputRate);
+                    if (due("pptTemp")) h.set<int>("pptTemp", pptTemp);
+                    if (!h.empty()) this->set(h);
+                    m_trainIdTracker.addSample(readTime, trainId);
+                    if (m_trainIdTracker.isReady()) {
+                        m_trainArrival = m_trainIdTracker.predictArrival(trainId).time_since_epoch().count();
+                        m_trainPeriod = std::chrono::duration_cast<TrainIdTracker::Clock::duration>(
+                                std::chrono::duration<double>(m_trainIdTracker.period())).count();
+                    }
+                    if (due("trainId") && m_burstAcquisition) updateBurstProgress(trainId, readTime, cycleDone);
+                    recordTelemetrySample(trainId);
+                    m_sessionStats.addTrainId(readTime, trainId);
+                    if (due("ethOutputRate") || due("watchdog") || due("throughput")) m_sessionStats.addOutputRate(outputRate);
+                    if (due("watchdog")) checkStall(trainId, outputRate, channelFailures);
+                    if (due("throughput")) updateThroughput(outputRate, congested);
+                }
+            }
 
-                uint32_t outputRate = m_ppt->getEPCParam("Eth_Output_Data_Rate", "0", "Eth_Output_Data_Rate")/(1E6/128.0);
-                this->set("ethOutputRate", outputRate);
-                this->set<int>("pptTemp", pptTemp);
+            if (due("linkHealth")) {
+                ok &= sampleLinkHealth();
+            }
 
-                std::this_thread::sleep_for(5000ms);
+            if (due("stats")) {
+                updateLockStats();
+                updatePptTiming();
+
+                Hash h;
+                const TelemetryMode mode = telemetryMode();
+                h.set("telemetry.mode", string(mode == TelemetryMode::ACQUIRING ? "ACQUIRING" : mode == TelemetryMode::ON ? "ON" : "IDLE"));
+                h.set("telemetry.numBatches", static_cast<unsigned long long> (m_telemetry.numBatches()));
+                h.set("telemetry.numReads", static_cast<unsigned long long> (m_telemetry.numReads()));
+                h.set("telemetry.numSkipped", static_cast<unsigned long long> (m_telemetry.numSkipped()));
+                this->set(h);
             }
         } catch (const Exception& e) {
             KARABO_LOG_FRAMEWORK_ERROR << getInstanceId() << " " << e;
+            return false;
         } catch (...) {
             KARABO_LOG_FRAMEWORK_ERROR << getInstanceId() << " Unknown exception was raised in poll thread";
+            return false;
+        }
+        return ok;
+    }
+
+
+    void DsscPpt::updateLockStats() {
+        const auto waitStats = m_accessToPptMutex.waitStats().summary();
+        const auto holdStats = m_accessToPptMutex.holdStats().summary();
+
+        vector<string> origins;
+        vector<unsigned long long> counts;
+        vector<double> waitP50, waitP95, waitMax;
+        vector<double> holdP50(waitStats.size(), 0.0), holdP95(waitStats.size(), 0.0), holdMax(waitStats.size(), 0.0);
+        for (const auto & stats : waitStats) {
+            origins.push_back(stats.name);
+            counts.push_back(stats.count);
+            waitP50.push_back(stats.p50);
+            waitP95.push_back(stats.p95);
+            waitMax.push_back(stats.max);
+        }
+        // hold statistics are only recorded on release, match them by origin
+        for (const auto & stats : holdStats) {
+            const auto it = std::find(origins.begin(), origins.end(), stats.name);
+            if (it == origins.end()) continue;
+            const size_t idx = it - origins.begin();
+            holdP50[idx] = stats.p50;
+            holdP95[idx] = stats.p95;
+            holdMax[idx] = stats.max;
+        }
+
+        Hash h;
+        h.set("lockStats.origins", origins);
+        h.set("lockStats.counts", counts);
+        h.set("lockStats.waitP50", waitP50);
+        h.set("lockStats.waitP95", waitP95);
+        h.set("lockStats.waitMax", waitMax);
+        h.set("lockStats.holdP50", holdP50);
+        h.set("lockStats.holdP95", holdP95);
+        h.set("lockStats.holdMax", holdMax);
+        h.set("lockStats.telemetryDropped", m_accessToPptMutex.numDropped());
+        this->set(h);
+    }
+
+
+    void DsscPpt::abortOperation() {
+        const auto snapshot = m_operation.snapshot();
+        if (m_operation.abort()) {
+            KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " Abort of " << snapshot.name << " requested during step "
+                    << snapshot.step << ", will stop after the current step";
+        } else {
+            KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " No operation running to abort";
+        }
+    }
+
+
+    void DsscPpt::publishOperationProgress() {
+        const auto snapshot = m_operation.snapshot();
+        Hash h;
+        h.set("operation.name", snapshot.name);
+        h.set("operation.step", snapshot.step);
+        h.set("operation.percent", snapshot.percent);
+        h.set("operation.elapsed", snapshot.elapsed);
+        h.set("operation.eta", snapshot.eta);
+        h.set("operation.result", OperationProgress::toString(snapshot.result));
+        this->set(h);
+    }
+
+
+    void DsscPpt::updatePptTiming() {
+        vector<string> operations;
+        vector<unsigned long long> counts;
+        vector<double> p50, p95, max;
+        for (const auto & stats : m_pptTiming.summary()) {
+            operations.push_back(stats.name);
+            counts.push_back(stats.count);
+            p50.push_back(stats.p50);
+            p95.push_back(stats.p95);
+            max.push_back(stats.max);
+        }
+
+        Hash h;
+        h.set("pptTiming.operations", operations);
+        h.set("pptTiming.counts", counts);
+        h.set("pptTiming.p50", p50);
+        h.set("pptTiming.p95", p95);
+        h.set("pptTiming.max", max);
+        this->set(h);
+    }
+
+
+    void DsscPpt::dumpPptTiming() {
+        updatePptTiming();
+
+        std::stringstream ss;
+        ss << getInstanceId() << " PPT call timing (last " << RollingLatency::WINDOW << " calls per operation, ms):\n";
+        ss << std::left << std::setw(32) << "operation" << std::right << std::setw(10) << "count"
+                << std::setw(12) << "p50" << std::setw(12) << "p95" << std::setw(12) << "max" << "\n";
+        for (const auto & stats : m_pptTiming.summary()) {
+            ss << std::left << std::setw(32) << stats.name << std::right << std::setw(10) << stats.count
+                    << std::fixed << std::setprecision(3)
+                    << std::setw(12) << stats.p50 << std::setw(12) << stats.p95 << std::setw(12) << stats.max << "\n";
+        }
+        KARABO_LOG_FRAMEWORK_INFO << ss.str();
+    }
+
+
+    void DsscPpt::readBackEPCRegisterCached(const std::string & moduleSet) {
+        const string cacheKey = "EPC/" + moduleSet;
+        if (m_readbackCache.lookup(cacheKey)) return;
+        {
+            DsscScopedLock lock(&m_accessToPptMutex, __func__);
+            m_ppt->readBackEPCRegister(moduleSet);
         }
+        m_readbackCache.update(cacheKey);
+    }
+
+
+    void DsscPpt::updateReadbackCacheStats() {
+        Hash h;
+        h.set("readbackCache.hits", static_cast<unsigned long long> (m_readbackCache.hits()));
+        h.set("readbackCache.misses", static_cast<unsigned long long> (m_readbackCache.misses()));
+        this->set(h);
     }
 
 
@@ -4709,6 +7246,7 @@ namespace karabo {
         KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Program PLL";
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
+            m_readbackCache.invalidate("EPC");
             if (get<bool>("pptPLL.internalPLL")) {
                 m_ppt->clockPLLSelect(true);
             } else {
@@ -4840,6 +7378,150 @@ namespace karabo {
     }
 
 
+    void DsscPpt::applyThrottleDivider(uint32_t divider) {
+        {
+            DsscScopedLock lock(&m_accessToPptMutex, __func__, PptAccess::CONTROL);
+            m_readbackCache.invalidate("EPC");
+            m_ppt->setEthernetOutputThrottleDivider(divider);
+        }
+        set<uint32_t>("ethThrottleDivider", divider);
+    }
+
+
+    string DsscPpt::throttleFileName() {
+        return "ConfigFiles/" + getInstanceId() + ".throttle";
+    }
+
+
+    string DsscPpt::throttleConfiguration() {
+        // the fastest divider depends on the receivers and on the data sent per train
+        std::ostringstream res;
+        for (int i = 1; i <= 4; i++) {
+            const string chan = "qsfp.chan" + toString(i) + ".recv.";
+            res << get<string>(chan + "macaddr") << "/" << get<string>(chan + "ipaddr") << ":" << get<unsigned int>(chan + "port") << ",";
+        }
+        res << get<unsigned int>("numFramesToSendOut") << "," << get<string>("sendingASICs");
+        return res.str();
+    }
+
+
+    double DsscPpt::readoutWindow(double outputRate) {
+        const auto sendingASICs = get<string>("sendingASICs");
+        const unsigned int numSendingAsics = (sendingASICs.length() == 17)
+                ? std::popcount(static_cast<uint16_t> (utils::bitEnableStringToValue(sendingASICs))) : 16;
+        // expectedChannelRate is for 10 trains per second
+        const double mbitPerTrain = ThroughputMeter::expectedChannelRate(get<unsigned int>("numFramesToSendOut"), numSendingAsics)
+                * m_ppt->activeIOBs.size() / 10;
+        return (outputRate > 0) ? 1000 * mbitPerTrain / outputRate : 0.0;
+    }
+
+
+    ThrottleTuner::Test DsscPpt::testThrottleDivider(uint32_t divider, double & outputRate) {
+        applyThrottleDivider(divider);
+        const unsigned long long lossCount = get<unsigned long long>("throttleTuning.frameLossCount");
+        set<bool>("throttleTuning.frameLoss", false);
+
+        const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(get<unsigned int>("throttleTuning.testTrains") * 100);
+        while (std::chrono::steady_clock::now() < end) {
+            if (m_operation.isAborted()) return ThrottleTuner::Test::ABORTED;
+            std::this_thread::sleep_for(100ms);
+        }
+
+        {
+            DsscScopedLock lock(&m_accessToPptMutex, __func__);
+            m_ppt->readBackEPCRegister("Eth_Output_Data_Rate");
+            outputRate = m_ppt->getEPCParam("Eth_Output_Data_Rate", "0", "Eth_Output_Data_Rate")/(1E6/128.0);
+        }
+        const bool loss = get<bool>("throttleTuning.frameLoss") || get<unsigned long long>("throttleTuning.frameLossCount") > lossCount;
+        KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Throttle divider " << divider << ": " << outputRate << " MBit/s"
+                << (loss ? ", frames lost" : "");
+        // no data is as bad as lost data
+        return (loss || outputRate == 0) ? ThrottleTuner::Test::LOSS : ThrottleTuner::Test::NO_LOSS;
+    }
+
+
+    void DsscPpt::autoTuneThrottle() {
+        EventLoop::post(karabo::util::bind_weak(&DsscPpt::autoTuneThrottle_impl, this));
+    }
+
+
+    void DsscPpt::autoTuneThrottle_impl() {
+        if (get<string>("throttleTuning.feedbackSource").empty()) {
+            KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " No receiver feeds back the frame loss, "
+                    "set throttleTuning.feedbackSource to tune the throttle divider";
+            return;
+        }
+
+        uint32_t start;
+        {
+            DsscScopedLock lock(&m_accessToPptMutex, __func__);
+            start = m_ppt->getEthernetOutputThrottleDivider();
+        }
+        ScopedOperation operation(m_operation, "autoTuneThrottle", ThrottleTuner::maxTests(start) + 1);
+
+        double startRate = 0;
+        if (!operation.nextStep("divider " + toString(start))) return;
+        const auto startTest = testThrottleDivider(start, startRate);
+        if (startTest == ThrottleTuner::Test::ABORTED) {
+            applyThrottleDivider(start);
+            return;
+        }
+        if (startTest == ThrottleTuner::Test::LOSS) {
+            KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " Frames are lost with the current throttle divider "
+                    << start << ", can not tune";
+            return;
+        }
+
+        ThrottleTuner tuner(start);
+        double rate = startRate;
+        while (!tuner.done()) {
+            const uint32_t divider = tuner.next();
+            double testRate = 0;
+            const auto test = operation.nextStep("divider " + toString(divider))
+                    ? testThrottleDivider(divider, testRate) : ThrottleTuner::Test::ABORTED;
+            if (test == ThrottleTuner::Test::ABORTED) {
+                // the search is incomplete, keep the divider used before tuning
+                KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " Throttle tuning aborted, keeping divider " << start;
+                applyThrottleDivider(start);
+                return;
+            }
+            if (test == ThrottleTuner::Test::NO_LOSS) rate = testRate;
+            tuner.report(test == ThrottleTuner::Test::LOSS);
+        }
+        // the last divider tested may have lost frames
+        applyThrottleDivider(tuner.result());
+
+        auto dividers = ThrottleTuner::load(throttleFileName());
+        dividers[throttleConfiguration()] = tuner.result();
+        if (!ThrottleTuner::save(throttleFileName(), dividers)) {
+            KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " Could not store the tuned throttle divider in " << throttleFileName();
+        }
+
+        const double before = readoutWindow(startRate);
+        const double after = readoutWindow(rate);
+        Hash h;
+        h.set<unsigned int>("throttleTuning.storedDivider", tuner.result());
+        h.set("throttleTuning.readoutWindowBefore", before);
+        h.set("throttleTuning.readoutWindowAfter", after);
+        h.set("throttleTuning.readoutWindowShrink", before - after);
+        this->set(h);
+        KARABO_LOG_FRAMEWORK_INFO << getInstanceId() << " Tuned throttle divider " << start << " -> " << tuner.result()
+                << " in " << tuner.numTests() << " tests, readout window " << before << " -> " << after << " ms";
+    }
+
+
+    void DsscPpt::applyTunedThrottle() {
+        const auto dividers = ThrottleTuner::load(throttleFileName());
+        const auto it = dividers.find(throttleConfiguration());
+        if (it == dividers.end()) {
+            KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " No throttle divider tuned for the current receiver configuration";
+            return;
+        }
+        applyThrottleDivider(it->second);
+        set<unsigned int>("throttleTuning.storedDivider", it->second);
+    }
+
+
     void DsscPpt::enableDPChannels(uint16_t enOneHot) {
         {
             DsscScopedLock lock(&m_accessToPptMutex, __func__);
@@ -4856,6 +7538,7 @@ namespace karabo {
         const auto iterations = get<unsigned int>("singleCycleFields.iterations");
         const auto slow_mode = get<unsigned int>("singleCycleFields.moduloValue");
 
+        // doSingleCycle is a 1 -> 0 pulse, nothing may get in between
         DsscScopedLock lock(&m_accessToPptMutex, __func__);
         m_ppt->setEPCParam("Single_Cycle_Register", "all", "iterations", iterations);
         m_ppt->setEPCParam("Single_Cycle_Register", "all", "slow_mode", slow_mode);
@@ -16,8 +16,29 @@
 #include "DsscPptAPI.hh"
 #include "DsscRegisterConfiguration.hh"
 #include "DsscConfigHashWriter.hh"
-
+#include "DsscPptLock.hh"
+#include "DsscOperationProgress.hh"
+#include "DsscReadbackCache.hh"
+#include "DsscHardwareFingerprint.hh"
+#include "DsscTelemetryScheduler.hh"
+#include "DsscTelemetryHistory.hh"
+#include "DsscTrainIdTracker.hh"
+#include "DsscStallWatchdog.hh"
+#include "DsscLinkHealth.hh"
+#include "DsscThroughputMeter.hh"
+#include "DsscThrottleTuner.hh"
+#include "DsscHotReconfig.hh"
+#include "DsscSessionStats.hh"
+#include "DsscJtagDirtyTracker.hh"
+#include "DsscPixelDeltaPlanner.hh"
+#include "DsscBroadcastPlanner.hh"
+
+#include <array>
 #include <atomic>
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
 #include <vector>
 #include <sstream>
 
@@ -52,49 +73,6 @@ namespace karabo {
         return camelCased;
    }
         
-    class SmartMutex : public std::mutex {
-
-    public:
-        using std::mutex::mutex;
-
-        void unlock() {
-            m_origin = "";
-            std::mutex::unlock();         
-        }
-
-        void trylock(const std::string & info) {
-            std::chrono::milliseconds interval(100);
-            int ncounts = 0;
-            while(!try_lock()){
-                std::this_thread::sleep_for(interval);
-                ++ncounts;
-                if(ncounts>50){
-                    std::cout << "---- SmarMutex could not lock mutex during 5 sec at " << info << ". Has been reserved by " << m_origin << std::endl;
-                    ncounts = 0;
-                }
-            }
-            m_origin = info;
-        }
-        std::string m_origin;
-    };
-
-    class DsscScopedLock {
-
-    public:
-
-        DsscScopedLock(SmartMutex * mutex, const std::string & info = "")
-            : m_mutex(mutex) {
-            m_mutex->trylock(info);
-        }
-
-        ~DsscScopedLock() {
-            m_mutex->unlock();
-        }
-
-    private:
-        SmartMutex * m_mutex;
-    };
-
     /** DSSC Patch Panel Transceiver C++ Karabo device
      */
     class DsscPpt : public karabo::core::Device {
@@ -188,6 +166,7 @@ namespace karabo {
         void doFastInit();
         void initSystem();
         void initSystem_impl();
+        bool initSystemSteps();
         void initSingleModule();
         void initGui();
         bool initIOBs();
@@ -207,6 +186,7 @@ namespace karabo {
         void resetASICs();
 
         void programAllIOBFPGAs(); //FPGA
+        void programAllIOBFPGAs_impl();
         void programIOBFPGA(int iobNumber);
         void programIOB1FPGA();
         void programIOB2FPGA();
@@ -237,9 +217,42 @@ namespace karabo {
         void programIOB4Config();
 
         void programJTAG();
+        // Programs the JTAG of all active modules, modules with identical content at once
+        void programJTAGAllModules();
+        void programJTAGAllModules_impl();
         void programPixelRegister();
+        // The ASIC registers of iobNumber, all if 0, were reset or programmed outside of the delta programming
+        void invalidateAsicState(int iobNumber = 0);
+        // Programs the JTAG module sets of iobNumber which are dirty, false on a failure
+        bool programJtagDelta(int iobNumber, bool readBack);
+        void programJtagModule(int iobNumber, bool readBack);
+        // Programs the JTAG of the modules with identical content in one pass, false on a failure
+        bool programJtagBroadcast(const std::vector<int> & iobs, bool readBack);
+        // Writable JTAG module sets in programming order, the xor module sets last
+        std::vector<std::string> jtagModuleSets();
+        // Values of the writable JTAG module sets of the active module
+        std::map<std::string, JtagDirtyTracker::Values> jtagContent();
+        // Programs the pixels of iobNumber changed since the last programming, false on a failure
+        bool programPixelDelta(int iobNumber, bool readBack);
         void programPixelRegisterDefault();
         void programSequencers(); 
+        bool isReadBackDeferred();
+        // Queues a readback of the target (JTAG, Pixel, Sequencer) programmed last at the IOB
+        void scheduleVerification(const std::string & target, int iobNumber);
+        void runVerification(const std::string & target, int iobNumber, unsigned long long generation);
+        // Reads back the target of the IOB right away, false on a mismatch
+        bool verifyModule(const std::string & target, int iobNumber);
+        // Reads back the parts of a snapshot still programmed at the IOB, taking the PPT lock per part.
+        // Deferred, the parts reached while the acquisition runs are cancelled.
+        std::map<std::string, bool> verifySnapshot(const std::string & target, int iobNumber,
+                                                   const std::map<std::string, std::vector<uint64_t>> & snapshot,
+                                                   bool deferred, std::vector<std::string> & changed,
+                                                   std::vector<std::string> & cancelled);
+        void recordVerification(const std::map<std::string, bool> & results, const std::vector<std::string> & changed,
+                                const std::vector<std::string> & cancelled, bool deferred);
+        // Register content of the target of the active module by the parts verified one by one
+        std::map<std::string, std::vector<uint64_t>> verificationContent(const std::string & target);
+        void publishVerificationStats();
         void updateSequencer();
 
         bool readbackConfigIOB(int iobNumber);
@@ -257,6 +270,8 @@ namespace karabo {
         void programLMK4();
 
         void updateFirmwareFlash();
+        void updateFirmwareFlash_impl();
+        void replyWhenDone(const std::function<void()> & work, const AsyncReply & reply);
         void updateLinuxFlash();
         void updateIOBFirmware();
         void _updateIOBFirmware();
@@ -353,8 +368,63 @@ namespace karabo {
         void setASICChannelReadoutFailure(int iobNumber);
         // 'acquire' thread
         void acquire();
-        // 'pollHardware' thread
-        void pollHardware();
+        // batch function of the telemetry scheduler, reads the due metrics under one lock
+        bool pollHardware(const std::vector<std::string> & metrics);
+        void initTelemetry();
+        // Adds a sample to the telemetry history and writes it to telemetryOutput
+        void recordTelemetrySample(unsigned long long trainId);
+        // Slot, replies the last numSamples telemetry samples, oldest first
+        void getTelemetryHistory(unsigned int numSamples);
+        void startSession();
+        // Publishes the summary of the running acquisition session, if any
+        void finishSession();
+        // Slot, replies the last numSessions acquisition sessions, oldest first
+        void getSessionHistory(unsigned int numSessions);
+        TelemetryMode telemetryMode();
+        std::chrono::milliseconds telemetryInterval(TelemetryMode mode);
+        void updateBurstProgress(unsigned long long trainId, TrainIdTracker::Clock::time_point readTime, bool cycleDone);
+        // Publishes the burst train ids, if a burst acquisition was running
+        void finishBurstAcquisition();
+        // Arms the PPT to send numTrains single cycles, false if the firmware can not count them
+        // The firmware counts the single cycles of a burst
+        bool isHardwareBurstSupported();
+        bool armHardwareBurst(unsigned int numTrains);
+        void startHardwareBurst();
+        // Samples one register of the link status of an IOB, false if the PPT was busy
+        bool sampleLinkHealth();
+        void resetLinkHealth();
+        void updateThroughput(uint32_t outputRate, const std::array<bool, ThroughputMeter::NUM_CHANNELS> & congested);
+        void resetStallWatchdog();
+        void checkStall(unsigned long long trainId, uint32_t outputRate, const std::map<int, uint16_t> & channelFailures);
+        void recoverStall(StallAction action, const std::vector<int> & iobs);
+        // False if sending is disabled or no frames or ASICs are sent
+        bool isDataExpected();
+        void updateStallWatchdogStats();
+        HardwareFingerprint readHardwareFingerprint();
+        std::string fingerprintFileName();
+        void saveHardwareFingerprint();
+        // Compares the hardware with the fingerprint stored by the last session
+        bool isWarmReconnectPossible();
+        void openTelemetryConnection();
+        void closeTelemetryConnection();
+        // Runs read on the telemetry connection if open, otherwise on the main
+        // connection with telemetry priority. Returns false if the lock on the
+        // main connection was not acquired within timeout (0: wait). read must
+        // not select a module, the telemetry connection only reads the EPC.
+        bool readTelemetry(const std::string & origin, std::chrono::milliseconds timeout,
+                           const std::function<void(SuS::DSSC_PPT_API &)> & read);
+        // Runs read on the main connection with telemetry priority, for reads which select an IOB.
+        // The telemetry connection is kept to EPC reads, the active module is restored afterwards.
+        bool readModuleTelemetry(const std::string & origin, std::chrono::milliseconds timeout,
+                                 const std::function<void(SuS::DSSC_PPT_API &)> & read);
+        // Reads back an EPC module set unless it was read back within the cache time to live
+        void readBackEPCRegisterCached(const std::string & moduleSet);
+        void updateReadbackCacheStats();
+        void updateLockStats();
+        void updatePptTiming();
+        void dumpPptTiming();
+        void abortOperation();
+        void publishOperationProgress();
         void updateGuiRegisters();
 
         void enableDPChannels(uint16_t enOneHot);
@@ -395,7 +465,17 @@ namespace karabo {
         void checkIrampCalibration();
 
         void updateStartWaitOffset();
-        void updateSequenceCounters(); // chip interface cont mode keeper
+        void updateSequenceCounters(); // chip interface hot reconfig keeper
+        // True if the changes can be written without a stop, then waits for the gap after the next train and sets gapStart
+        bool beginHotReconfig(const std::vector<HotReconfigPolicy::Change> & changes, HotReconfigPolicy::Clock::time_point & gapStart);
+        // Start of the gap after the next train
+        HotReconfigPolicy::Clock::time_point waitForTrainGap();
+        HotReconfigPolicy::Clock::duration trainPeriod();
+        // Waits for the next gap if a write of writeTime does not fit into the current one, needs no PPT lock
+        void waitForWriteGap(HotReconfigPolicy::Clock::time_point & gapStart, HotReconfigPolicy::Clock::duration writeTime);
+        void endHotReconfig(HotReconfigPolicy::Clock::time_point gapStart);
+        std::vector<HotReconfigPolicy::Change> registerChanges(const karabo::data::Hash & data);
+        void setHotReconfigPatterns(const karabo::data::Hash & config);
 
         void waitJTAGEngineDone();
 
@@ -403,6 +483,16 @@ namespace karabo {
         void SaveQSFPNetConfig();
 
         void setThrottleDivider();
+        void autoTuneThrottle();
+        void autoTuneThrottle_impl();
+        void applyTunedThrottle();
+        void applyThrottleDivider(uint32_t divider);
+        // Returns true if frames were lost while sending with divider
+        ThrottleTuner::Test testThrottleDivider(uint32_t divider, double & outputRate);
+        std::string throttleFileName();
+        std::string throttleConfiguration();
+        // Time to send the data of one train at outputRate in ms
+        double readoutWindow(double outputRate);
         void updateGainHashValue();  // Karabo slot
         void updateGainHashValue_impl();   // Background task implementation
         void updateConfigSchema();
@@ -442,6 +532,73 @@ namespace karabo {
             data::State lastState;
         };
 
+        // Writes register changes while running, changes safe between trains in the gaps after the trains,
+        // all others immediately with the device in CHANGING like DSSC::StateChangeKeeper
+        class HotReconfigKeeper {
+
+        public:
+
+            HotReconfigKeeper(DsscPpt *ppt, const std::vector<HotReconfigPolicy::Change> & changes) : dsscPpt(ppt) {
+                hot = dsscPpt->beginHotReconfig(changes, gapStart);
+                if (!hot) {
+                    lastState = dsscPpt->getState();
+                    dsscPpt->updateState(data::State::CHANGING);
+                }
+                lastWrite = HotReconfigPolicy::Clock::now();
+            }
+
+            ~HotReconfigKeeper() {
+                if (hot) {
+                    dsscPpt->endHotReconfig(gapStart);
+                } else {
+                    dsscPpt->updateState(lastState);
+                }
+            }
+
+            // Writes are done in the train gaps, the PPT lock must not be held while waiting for them
+            bool isHot() const {
+                return hot;
+            }
+
+            // Before every further write, waits for the next gap if the last write would not fit into the current one
+            void nextWrite() {
+                if (!hot) return;
+                dsscPpt->waitForWriteGap(gapStart, HotReconfigPolicy::Clock::now() - lastWrite);
+                lastWrite = HotReconfigPolicy::Clock::now();
+            }
+
+        private:
+
+            DsscPpt *dsscPpt;
+            bool hot;
+            HotReconfigPolicy::Clock::time_point gapStart;
+            HotReconfigPolicy::Clock::time_point lastWrite;
+            data::State lastState;
+        };
+
+        // Switches the PPT to a module and back to the module active before, the PPT lock must be held
+        class ActiveModuleKeeper {
+
+        public:
+
+            ActiveModuleKeeper(SuS::DSSC_PPT_API *ppt, int iobNumber) : pptApi(ppt), lastModule(ppt->getActiveModuleNumber()) {
+                if (iobNumber > 0) {
+                    pptApi->setActiveModule(iobNumber);
+                }
+            }
+
+            ~ActiveModuleKeeper() {
+                if (lastModule > 0) {
+                    pptApi->setActiveModule(lastModule);
+                }
+            }
+
+        private:
+
+            SuS::DSSC_PPT_API *pptApi;
+            int lastModule;
+        };
+
     private:
         
         inline std::string sanitizeKey(const std::string& key){
@@ -481,11 +638,24 @@ namespace karabo {
         }
         
         bool m_keepAcquisition;
-        bool m_keepPolling;
-        std::shared_ptr<std::thread> m_pollThread;
         SmartMutex m_accessToPptMutex;
+        // second, read-only connection for telemetry, see telemetryConnection
+        SmartMutex m_telemetryMutex;
+        PPT_Pointer m_telemetryPpt;
         std::mutex m_outMutex;
         PPT_Pointer m_ppt; // Use your main PPT class here
+        RollingStatsTable m_pptTiming;
+        OperationProgress m_operation;
+        ReadbackCache m_readbackCache;
+        std::mutex m_verificationMutex;
+        std::map<std::string, unsigned long long> m_verificationGenerations;
+        // content programmed by the latest generation, the readback is compared against
+        std::map<std::string, std::map<std::string, std::vector<uint64_t>>> m_verificationSnapshots;
+        std::set<std::string> m_verificationMismatches;
+        unsigned int m_numPendingVerifications;
+        unsigned long long m_numVerified;
+        unsigned long long m_numMismatches;
+        unsigned long long m_numCancelledVerifications;
         karabo::data::Schema m_schema;
         std::string m_epcTag;
         std::string m_ethTag;
@@ -498,10 +668,36 @@ namespace karabo {
 
         
         std::atomic<bool> m_burstAcquisition;
+        // burst progress, updated from the telemetry thread
+        std::atomic<unsigned long long> m_burstFirstTrainId;
+        std::atomic<unsigned long long> m_burstLastTrainId;
+        std::atomic<unsigned long long> m_burstCurrentTrainId;
+        std::atomic<unsigned long long> m_burstDoneTrainId; // read when the end of the burst was seen
+        std::atomic<bool> m_burstFirstTrain;
+        std::atomic<unsigned int> m_burstPollInterval; // ms
+        std::atomic<unsigned int> m_burstTrainIdReads;
+        std::atomic<bool> m_burstHardware; // the PPT counts the trains of the burst
+        std::atomic<bool> m_burstArmed;
+        TrainIdTracker m_trainIdTracker; // telemetry thread only
+        TelemetryScheduler m_telemetry;
+        TelemetryHistory m_telemetryHistory;
+        std::array<std::atomic<int>, 4> m_iobTemps{};
+        StallWatchdog m_stallWatchdog;
+        LinkHealth m_linkHealth;
+        size_t m_linkHealthIndex = 0; // telemetry thread only
+        ThroughputMeter m_throughputMeter;
+        HotReconfigPolicy m_hotReconfig;
+        SessionStats m_sessionStats;
+        JtagDirtyTracker m_jtagTracker;
+        PixelDeltaPlanner m_pixelPlanner;
+        BroadcastPlanner m_broadcastPlanner;
+        // train clock for hot reconfiguration, updated from the telemetry thread
+        std::atomic<long long> m_trainArrival{0}; // ns of the steady clock
+        std::atomic<long long> m_trainPeriod{0}; // ns, 0 if unknown
+        std::map<std::string, int> m_sequenceCounters; // last written
         
         karabo::data::Hash m_last_config_hash;
         
-        void burstAcquisitionPolling();
         bool getConfigurationFromRemote();
         void requestScene(const karabo::data::Hash&);
         bool check_iob(const int);
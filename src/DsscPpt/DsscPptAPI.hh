@@ -9,6 +9,15 @@
 #define	DSSC_PPT_API_H
 
 #include "DSSC_PPT.h"
+#include "DsscLatencyStats.hh"
+
+// Shadows DSSC_PPT::name with a call recording its duration under "name"
+#define DSSC_PPT_API_TIMED(name) \
+    template <typename... Args> \
+    decltype(auto) name(Args&&... args) \
+    { \
+        return timed(#name, [&]() -> decltype(auto) {return DSSC_PPT::name(std::forward<Args>(args)...);}); \
+    }
 
 
 namespace SuS{
@@ -92,11 +101,66 @@ public:
       std::cout << "SramTest can not be implemented in DSSC_PPT_API" << std::endl;
     }
 
+    inline void setActiveModule(int modNumber)
+    {
+        DSSC_PPT::setActiveModule(modNumber);
+        m_activeModule = modNumber;
+    }
+
+    // module set by the last setActiveModule, 0 if none
+    inline int getActiveModuleNumber() const {return m_activeModule;}
+
+    // the durations of the calls below are recorded into the table, if one is set
+    inline void setTimingTable(karabo::RollingStatsTable * timing) {m_timing = timing;}
+
+    DSSC_PPT_API_TIMED(openConnection)
+    DSSC_PPT_API_TIMED(initSystem)
+    DSSC_PPT_API_TIMED(initSingleModule)
+    DSSC_PPT_API_TIMED(initIOBs)
+    DSSC_PPT_API_TIMED(initChip)
+    DSSC_PPT_API_TIMED(resetAll)
+    DSSC_PPT_API_TIMED(programIOBFPGA)
+    DSSC_PPT_API_TIMED(auroraTXReset)
+    DSSC_PPT_API_TIMED(runContinuousMode)
+    DSSC_PPT_API_TIMED(programJtag)
+    DSSC_PPT_API_TIMED(programJtagSingle)
+    DSSC_PPT_API_TIMED(programPixelRegs)
+    DSSC_PPT_API_TIMED(programPixelRegsAllAtOnce)
+    DSSC_PPT_API_TIMED(programSequencers)
+    DSSC_PPT_API_TIMED(programEPCRegister)
+    DSSC_PPT_API_TIMED(programEPCRegisters)
+    DSSC_PPT_API_TIMED(programIOBRegister)
+    DSSC_PPT_API_TIMED(programIOBRegisters)
+    DSSC_PPT_API_TIMED(readBackEPCRegister)
+    DSSC_PPT_API_TIMED(readBackEPCRegisters)
+    DSSC_PPT_API_TIMED(readBackIOBRegister)
+    DSSC_PPT_API_TIMED(checkCurrentIOBPRBStatus)
+    DSSC_PPT_API_TIMED(checkIOBDataFailed)
+    DSSC_PPT_API_TIMED(isAuroraReady)
+    DSSC_PPT_API_TIMED(getCurrentTrainID)
+    DSSC_PPT_API_TIMED(readFPGATemperature)
+    DSSC_PPT_API_TIMED(readIOBTemperature_TestSystem)
+
 private:
 
+    template <typename Call>
+    decltype(auto) timed(const char * name, Call && call)
+    {
+        if (m_timing == nullptr) {
+            return call();
+        }
+        karabo::ScopedLatencyTimer timer(*m_timing, name);
+        return call();
+    }
+
+    int m_activeModule = 0;
+    karabo::RollingStatsTable * m_timing = nullptr;
+
 };
 
 }
 
+#undef DSSC_PPT_API_TIMED
+
 #endif	/* DSSC_PPT_API_H */
 
@@ -0,0 +1,168 @@
+/*
+ * File:   DsscPptLock.hh
+ *
+ * Priority aware lock guarding the connection to the PPT.
+ */
+
+#ifndef DSSCPPTLOCK_HH
+#define DSSCPPTLOCK_HH
+
+#include <karabo/karabo.hpp>
+
+#include "DsscLatencyStats.hh"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
+namespace karabo {
+
+    /**
+     * Priority classes for access to the PPT connection. When the lock is
+     * released it is handed to a waiter of the highest class: operator
+     * control commands (start/stop) before programming, programming before
+     * telemetry reads.
+     */
+    enum class PptAccess : int {
+        TELEMETRY = 0,
+        PROGRAMMING = 1,
+        CONTROL = 2
+    };
+
+    /**
+     * Mutex guarding the PPT connection. Waiters block on a condition variable
+     * and are woken on release. Wait and hold times are recorded per origin
+     * (the function name passed by DsscScopedLock).
+     */
+    class SmartMutex {
+
+    public:
+
+        void setName(const std::string & name) {
+            m_name = name;
+        }
+
+        /**
+         * Blocks until the lock is free and no waiter of a higher class is
+         * queued. With a timeout > 0 gives up after the timeout and returns
+         * false, used by telemetry reads which are stale when delayed.
+         */
+        bool lock(const std::string & info, PptAccess access = PptAccess::PROGRAMMING,
+                  std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+            const auto waitStart = std::chrono::steady_clock::now();
+            const int cls = static_cast<int> (access);
+            std::unique_lock<std::mutex> lock(m_stateMutex);
+            auto isFree = [this, cls] {
+                if (m_locked) return false;
+                for (int higher = cls + 1; higher < NUM_CLASSES; ++higher) {
+                    if (m_waiting[higher] > 0) return false;
+                }
+                return true;
+            };
+
+            ++m_waiting[cls];
+            if (timeout.count() > 0) {
+                if (!m_released.wait_until(lock, waitStart + timeout, isFree)) {
+                    --m_waiting[cls];
+                    ++m_numDropped;
+                    return false;
+                }
+            } else {
+                while (!m_released.wait_for(lock, std::chrono::seconds(5), isFree)) {
+                    const double heldSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_acquired).count();
+                    KARABO_LOG_FRAMEWORK_WARN << m_name << " could not lock PPT access during 5 sec at " << info
+                            << ". Has been reserved by " << m_origin << " for " << heldSec << " sec";
+                }
+            }
+            --m_waiting[cls];
+
+            m_locked = true;
+            m_origin = info;
+            m_acquired = std::chrono::steady_clock::now();
+            const double waitMs = std::chrono::duration<double, std::milli>(m_acquired - waitStart).count();
+            m_waitStats.add(info, waitMs);
+            m_totalWait += waitMs;
+            return true;
+        }
+
+        void unlock() {
+            {
+                std::lock_guard<std::mutex> lock(m_stateMutex);
+                m_holdStats.add(m_origin, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_acquired).count());
+                m_origin = "";
+                m_locked = false;
+            }
+            // waiters of different classes share the condition variable
+            m_released.notify_all();
+        }
+
+        std::string origin() {
+            std::lock_guard<std::mutex> lock(m_stateMutex);
+            return m_origin;
+        }
+
+        const LatencyStatsTable & waitStats() const {
+            return m_waitStats;
+        }
+
+        const LatencyStatsTable & holdStats() const {
+            return m_holdStats;
+        }
+
+        // total time waited for the lock in ms
+        double totalWaitTime() {
+            std::lock_guard<std::mutex> lock(m_stateMutex);
+            return m_totalWait;
+        }
+
+        // number of timed out (dropped) lock requests
+        unsigned long long numDropped() {
+            std::lock_guard<std::mutex> lock(m_stateMutex);
+            return m_numDropped;
+        }
+
+    private:
+
+        static constexpr int NUM_CLASSES = 3;
+
+        std::mutex m_stateMutex;
+        std::condition_variable m_released;
+        bool m_locked = false;
+        int m_waiting[NUM_CLASSES] = {0, 0, 0};
+        unsigned long long m_numDropped = 0;
+        double m_totalWait = 0;
+        std::string m_origin;
+        std::string m_name;
+        std::chrono::steady_clock::time_point m_acquired;
+        LatencyStatsTable m_waitStats;
+        LatencyStatsTable m_holdStats;
+    };
+
+    class DsscScopedLock {
+
+    public:
+
+        DsscScopedLock(SmartMutex * mutex, const std::string & info = "",
+                       PptAccess access = PptAccess::PROGRAMMING,
+                       std::chrono::milliseconds timeout = std::chrono::milliseconds(0))
+            : m_mutex(mutex) {
+            m_owns = m_mutex->lock(info, access, timeout);
+        }
+
+        ~DsscScopedLock() {
+            if (m_owns) m_mutex->unlock();
+        }
+
+        // false if a lock with timeout was not acquired in time
+        bool owns() const {
+            return m_owns;
+        }
+
+    private:
+        SmartMutex * m_mutex;
+        bool m_owns;
+    };
+}
+
+#endif
@@ -583,6 +583,16 @@ void init_config_register_elements(karabo::data::Schema& schema) {
                 .expertAccess()
                 .commit();
 
+            STRING_ELEMENT(schema)
+                .key("readBackMode").displayedName("Readback Mode")
+                .description("SYNC: enabled readbacks are done while programming. DEFERRED: programming writes "
+                             "only, enabled readbacks are done afterwards as a low priority job which shifts the "
+                             "register content in again and compares it, see verification. The readback of a "
+                             "module set waits for every other command and is cancelled once the acquisition is started")
+                .assignmentOptional().defaultValue("SYNC").options("SYNC,DEFERRED").reconfigurable()
+                .expertAccess()
+                .commit();
+
             UINT32_ELEMENT(schema).key("activeModule")
                 .displayedName("Active Module")
                 .description("global control for active IOB module,  1 - 4")
@@ -601,6 +611,14 @@ void init_config_register_elements(karabo::data::Schema& schema) {
                 .expertAccess()
                 .commit();
 
+            SLOT_ELEMENT(schema)
+                .key("programJTAGAllModules")
+                .displayedName("Program All JTAG")
+                .description("Program JTAG of all active Modules, identical Modules at once")
+                .allowedStates(State::ON, State::STOPPED)
+                .expertAccess()
+                .commit();
+
             SLOT_ELEMENT(schema)
                 .key("programPixelRegisterDefault")
                 .displayedName("Program PixelRegister Default")
@@ -813,6 +831,32 @@ void init_iob_element(karabo::data::Schema& schema, int iobNum) {
                 .description("Asic channel readout failure, no data was detekted from channel after readout command, maybe no asic connected")
                 .readOnly()
                 .commit();
+
+        UINT64_ELEMENT(schema)
+                .key("iob" + iobIdx + "Status.linkSamples")
+                .displayedName("Link Samples")
+                .description("Channel readout failure samples taken by the link health sampler")
+                .readOnly()
+                .defaultValue(0)
+                .commit();
+
+        VECTOR_UINT64_ELEMENT(schema)
+                .key("iob" + iobIdx + "Status.asicFailureCounts")
+                .displayedName("ASIC Failure Counts")
+                .description("Samples with a channel readout failure, per ASIC")
+                .readOnly()
+                .defaultValue(std::vector<unsigned long long>(16, 0))
+                .commit();
+
+        for (const std::string window : {"1min", "10min", "60min"}) {
+            VECTOR_DOUBLE_ELEMENT(schema)
+                    .key("iob" + iobIdx + "Status.asicFailureRate" + window)
+                    .displayedName("ASIC Failure Rate " + window)
+                    .description("Fraction of the samples of the last " + window + " with a channel readout failure, per ASIC")
+                    .readOnly()
+                    .defaultValue(std::vector<double>(16, 0.0))
+                    .commit();
+        }
 }
 
 
@@ -964,6 +1008,44 @@ void init_ethernet_element(karabo::data::Schema& schema, int CH, int ADDR) {
                 .defaultValue(8000)
                 .reconfigurable()
                 .commit();
+
+        DOUBLE_ELEMENT(schema).key("qsfp.chan" + ch + ".estimatedRate")
+                .displayedName("Estimated Rate")
+                .description("Estimated output rate in MBit/s over the meter window. The PPT measures the rate of all "
+                             "channels, their deficit is attributed to the congested channels. XFEL mode only")
+                .readOnly()
+                .defaultValue(0.0)
+                .commit();
+
+        DOUBLE_ELEMENT(schema).key("qsfp.chan" + ch + ".expectedRate")
+                .displayedName("Expected Rate")
+                .description("Output rate in MBit/s expected from numFramesToSendOut and sendingASICs, 0 if the IOB is not active")
+                .readOnly()
+                .defaultValue(0.0)
+                .commit();
+
+        DOUBLE_ELEMENT(schema).key("qsfp.chan" + ch + ".deficit")
+                .displayedName("Deficit")
+                .description("Output rate missing to the expected rate in percent, attributed to the channel by its "
+                             "congestion. XFEL mode only, the expected rate assumes 10 trains per second")
+                .readOnly()
+                .defaultValue(0.0)
+                .commit();
+
+        DOUBLE_ELEMENT(schema).key("qsfp.chan" + ch + ".congestion")
+                .displayedName("Congestion")
+                .description("Fraction of the samples with full output fifos or without PCS block lock")
+                .readOnly()
+                .defaultValue(0.0)
+                .commit();
+
+        BOOL_ELEMENT(schema).key("qsfp.chan" + ch + ".belowExpected")
+                .displayedName("Below Expected")
+                .description("Deficit above qsfp.deficitThreshold, only raised with congestion of the channel, "
+                             "see qsfp.belowExpected for all channels. XFEL mode only")
+                .readOnly()
+                .defaultValue(false)
+                .commit();
 }
 
 
@@ -974,6 +1056,47 @@ void init_eth_elements(karabo::data::Schema& schema) {
                 .expertAccess()
                 .commit();
 
+        UINT32_ELEMENT(schema).key("qsfp.meterInterval")
+                .displayedName("Meter Interval")
+                .description("Interval of the output rate samples while acquiring in ms, 0 disables the metering")
+                .assignmentOptional().defaultValue(1000).reconfigurable()
+                .commit();
+
+        UINT32_ELEMENT(schema).key("qsfp.meterWindow")
+                .displayedName("Meter Window")
+                .description("Window of the output rates in s")
+                .assignmentOptional().defaultValue(10).reconfigurable()
+                .minInc(1)
+                .commit();
+
+        DOUBLE_ELEMENT(schema).key("qsfp.deficitThreshold")
+                .displayedName("Deficit Threshold")
+                .description("Deficit in percent from which a channel is below expected")
+                .assignmentOptional().defaultValue(10.0).reconfigurable()
+                .commit();
+
+        DOUBLE_ELEMENT(schema).key("qsfp.expectedRate")
+                .displayedName("Expected Rate")
+                .description("Output rate in MBit/s expected from all active channels")
+                .readOnly()
+                .defaultValue(0.0)
+                .commit();
+
+        DOUBLE_ELEMENT(schema).key("qsfp.deficit")
+                .displayedName("Deficit")
+                .description("Output rate of all channels missing to the expected rate in percent over the meter "
+                             "window, including deficit no congestion points to a channel. XFEL mode only")
+                .readOnly()
+                .defaultValue(0.0)
+                .commit();
+
+        BOOL_ELEMENT(schema).key("qsfp.belowExpected")
+                .displayedName("Below Expected")
+                .description("Deficit of all channels above qsfp.deficitThreshold. XFEL mode only")
+                .readOnly()
+                .defaultValue(false)
+                .commit();
+
         init_ethernet_element(schema, 1, 0);
         init_ethernet_element(schema, 2, 1);
         init_ethernet_element(schema, 3, 2);
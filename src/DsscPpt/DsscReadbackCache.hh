@@ -0,0 +1,125 @@
+/*
+ * File:   DsscReadbackCache.hh
+ *
+ * Time-to-live cache of PPT register readbacks.
+ */
+
+#ifndef DSSCREADBACKCACHE_HH
+#define DSSCREADBACKCACHE_HH
+
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace karabo {
+
+    /**
+     * Remembers when a register was last read back from the hardware, so a
+     * readback repeated within the time to live can be skipped and the
+     * values already in the local register model be used instead.
+     *
+     * Keys are either a group ("EPC", "IOB1") for a readback of all its
+     * registers or "group/moduleSet" for a single one. A fresh group makes
+     * all its module sets fresh. Invalidating a module set also invalidates
+     * its group, invalidating a group drops all its module sets.
+     *
+     * Status registers change without being written (lock bits, counters,
+     * temperatures), a lookup of them always misses.
+     */
+    class ReadbackCache {
+
+    public:
+
+        using Clock = std::chrono::steady_clock;
+
+        ReadbackCache() : m_ttl(0), m_hits(0), m_misses(0) {
+        }
+
+        // 0 disables the cache
+        void setTimeToLive(std::chrono::milliseconds ttl) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_ttl = ttl;
+        }
+
+        /**
+         * Returns true and counts a hit if the key was read back within the
+         * time to live, otherwise counts a miss. The caller is expected to
+         * read back the register and call update() on a miss.
+         */
+        bool lookup(const std::string & key) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const auto now = Clock::now();
+            const size_t pos = key.find('/');
+            const bool status = (pos != std::string::npos) && isStatusRegister(key.substr(pos + 1));
+            if (m_ttl.count() > 0 && !status && (isFresh(key, now) || isFresh(group(key), now))) {
+                m_hits++;
+                return true;
+            }
+            m_misses++;
+            return false;
+        }
+
+        void update(const std::string & key) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_readTimes[key] = Clock::now();
+        }
+
+        void invalidate(const std::string & key) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const std::string grp = group(key);
+            if (grp == key) {
+                for (auto it = m_readTimes.begin(); it != m_readTimes.end();) {
+                    it = (group(it->first) == grp) ? m_readTimes.erase(it) : std::next(it);
+                }
+            } else {
+                m_readTimes.erase(key);
+                m_readTimes.erase(grp);
+            }
+        }
+
+        void invalidateAll() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_readTimes.clear();
+        }
+
+        // Module sets holding hardware status, by name, and the clock control holding the MMCM lock
+        static bool isStatusRegister(const std::string & moduleSet) {
+            for (const char * part : {"Readback", "Status", "Temp", "Rate", "Build"}) {
+                if (moduleSet.find(part) != std::string::npos) return true;
+            }
+            return moduleSet == "CLOCK_FANOUT_CONTROL";
+        }
+
+        uint64_t hits() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_hits;
+        }
+
+        uint64_t misses() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_misses;
+        }
+
+    private:
+
+        static std::string group(const std::string & key) {
+            return key.substr(0, key.find('/'));
+        }
+
+        bool isFresh(const std::string & key, Clock::time_point now) const {
+            auto it = m_readTimes.find(key);
+            return it != m_readTimes.end() && now - it->second < m_ttl;
+        }
+
+        mutable std::mutex m_mutex;
+        std::chrono::milliseconds m_ttl;
+        std::map<std::string, Clock::time_point> m_readTimes;
+        uint64_t m_hits;
+        uint64_t m_misses;
+    };
+}
+
+#endif
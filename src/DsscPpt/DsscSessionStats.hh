@@ -0,0 +1,172 @@
+/*
+ * File:   DsscSessionStats.hh
+ *
+ * Summary statistics of acquisition sessions.
+ */
+
+#ifndef DSSCSESSIONSTATS_HH
+#define DSSCSESSIONSTATS_HH
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace karabo {
+
+    struct AcquisitionSession {
+
+        double startTime; // seconds since epoch
+        double stopTime; // seconds since epoch
+        uint64_t firstTrainId;
+        uint64_t lastTrainId;
+        uint64_t trainsExpected; // from the duration of the session
+        uint64_t trainsSeen;
+        uint64_t numGaps; // train id jumps, freezes or resets
+        double meanOutputRate; // MBit/s
+        double minOutputRate; // MBit/s
+        double recoveryTime; // s
+        double lockWaitTime; // ms, waited for the PPT lock during the session
+    };
+
+    /**
+     * Collects the train ids and output rates sampled while acquiring and
+     * keeps the summaries of the last MAX_SESSIONS sessions.
+     *
+     * Train ids are sampled, not read for every train. A jump of the train id
+     * by more than the time since its last change explains, or a train id
+     * which does not advance, is a gap. Its trains are missing from the
+     * trains seen, a freeze ending in a jump is counted once.
+     */
+    class SessionStats {
+
+    public:
+
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t MAX_SESSIONS = 100;
+        // trains the train id may be off the expectation without a gap
+        static constexpr double TOLERANCE = 2.0;
+
+        explicit SessionStats(std::chrono::duration<double> period = std::chrono::milliseconds(100)) :
+            m_period(period.count()), m_running(false) {
+        }
+
+        bool isRunning() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_running;
+        }
+
+        void start(Clock::time_point now, double wallTime, double lockWaitTime) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_current = AcquisitionSession{};
+            m_current.startTime = wallTime;
+            m_current.lockWaitTime = lockWaitTime; // total until now, the difference is taken on stop
+            m_startTime = now;
+            m_numRates = 0;
+            m_missed = 0;
+            m_frozenTrains = 0;
+            m_hasTrain = false;
+            m_running = true;
+        }
+
+        void addTrainId(Clock::time_point time, uint64_t trainId) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_running) return;
+            if (!m_hasTrain) {
+                m_current.firstTrainId = trainId;
+            } else if (trainId < m_lastTrainId) {
+                // reset of the train id, the trains in between are unknown
+                m_current.numGaps++;
+                endFreeze(0);
+            } else {
+                // trains expected since the train id last changed
+                const double expected = std::chrono::duration<double>(time - m_lastTime).count() / m_period;
+                const uint64_t advance = trainId - m_lastTrainId;
+                if (advance == 0) {
+                    if (expected >= TOLERANCE) {
+                        if (m_frozenTrains == 0) m_current.numGaps++;
+                        m_frozenTrains = expected;
+                    }
+                    return;
+                }
+                const double jumped = advance - expected;
+                if (m_frozenTrains > 0) {
+                    endFreeze(jumped);
+                } else if (jumped > TOLERANCE) {
+                    m_current.numGaps++;
+                    m_missed += jumped;
+                }
+            }
+            m_current.lastTrainId = trainId;
+            m_lastTrainId = trainId;
+            m_lastTime = time;
+            m_hasTrain = true;
+        }
+
+        void addOutputRate(double rate) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_running) return;
+            m_current.minOutputRate = (m_numRates == 0) ? rate : std::min(m_current.minOutputRate, rate);
+            m_current.meanOutputRate += (rate - m_current.meanOutputRate) / ++m_numRates;
+        }
+
+        void addRecoveryTime(std::chrono::duration<double> time) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_running) m_current.recoveryTime += time.count();
+        }
+
+        // Ends the session and returns its summary, the session is empty if none was running
+        AcquisitionSession stop(Clock::time_point now, double wallTime, double lockWaitTime) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_running) return AcquisitionSession{};
+            m_running = false;
+            endFreeze(0);
+
+            AcquisitionSession & session = m_current;
+            session.stopTime = wallTime;
+            session.lockWaitTime = lockWaitTime - session.lockWaitTime;
+            const double duration = std::chrono::duration<double>(now - m_startTime).count();
+            session.trainsExpected = std::llround(duration / m_period);
+            session.trainsSeen = std::llround(std::max(0.0, session.trainsExpected - m_missed));
+            session.trainsSeen = std::min(session.trainsSeen, session.trainsExpected);
+
+            m_sessions.push_back(session);
+            if (m_sessions.size() > MAX_SESSIONS) m_sessions.pop_front();
+            return session;
+        }
+
+        // Up to the last numSessions sessions, oldest first
+        std::vector<AcquisitionSession> last(size_t numSessions) const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const size_t num = std::min(numSessions, m_sessions.size());
+            return std::vector<AcquisitionSession>(m_sessions.end() - num, m_sessions.end());
+        }
+
+    private:
+
+        // A freeze ends with the train id advancing by jumped more than expected
+        void endFreeze(double jumped) {
+            m_missed += std::max(m_frozenTrains, jumped);
+            m_frozenTrains = 0;
+        }
+
+        mutable std::mutex m_mutex;
+        double m_period; // s
+        bool m_running;
+        AcquisitionSession m_current{};
+        Clock::time_point m_startTime;
+        size_t m_numRates = 0;
+        double m_missed = 0;
+        double m_frozenTrains = 0;
+        bool m_hasTrain = false;
+        uint64_t m_lastTrainId = 0;
+        Clock::time_point m_lastTime; // of the last change of the train id
+        std::deque<AcquisitionSession> m_sessions;
+    };
+}
+
+#endif
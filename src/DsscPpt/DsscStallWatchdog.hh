@@ -0,0 +1,214 @@
+/*
+ * File:   DsscStallWatchdog.hh
+ *
+ * Detection of stalled acquisitions and choice of the recovery.
+ */
+
+#ifndef DSSCSTALLWATCHDOG_HH
+#define DSSCSTALLWATCHDOG_HH
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace karabo {
+
+    enum class StallAction {
+        NONE, AURORA_RESET, REINIT_MODULE, GIVE_UP
+    };
+
+    struct StallRecovery {
+
+        StallAction action;
+        std::vector<int> iobs; // IOBs to recover
+        std::string reason;
+    };
+
+    /**
+     * Watches the samples taken while acquiring and detects a stall if, for
+     * the stall time, the train id does not advance, no data is sent, or an
+     * IOB reports failing ASIC channels.
+     *
+     * A stall is recovered with the cheapest action first: an aurora reset
+     * of the failing IOBs (all IOBs if none reports failures), then a
+     * re-init of these IOBs. A recovery succeeded if no stall shows up
+     * within the stall time after the action, otherwise the next action is
+     * chosen. A stalled train id is not recovered, the clock comes from
+     * the timing system. The watchdog gives up until the stall clears.
+     */
+    class StallWatchdog {
+
+    public:
+
+        using Clock = std::chrono::steady_clock;
+
+        StallWatchdog() : m_stallTime(2000), m_started(false), m_state(State::WATCHING), m_level(0),
+            m_numStalls(0), m_numRecoveries(0), m_numRecovered(0), m_numFailedRecoveries(0), m_lastRecoveryTime(0) {
+        }
+
+        void setStallTime(std::chrono::milliseconds stallTime) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stallTime = stallTime;
+        }
+
+        // Forgets the progress seen so far, e.g. when an acquisition starts
+        void reset() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_started = false;
+            m_failingSince.clear();
+            m_state = State::WATCHING;
+            m_level = 0;
+        }
+
+        // Takes a sample, the returned recovery has to be run and confirmed by recoveryFinished()
+        StallRecovery update(Clock::time_point now, uint64_t trainId, uint32_t outputRate,
+                             const std::map<int, uint16_t> & channelFailures) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_started) {
+                m_started = true;
+                m_lastTrainId = trainId;
+                m_trainProgress = now;
+                m_outputProgress = now;
+            }
+            if (trainId != m_lastTrainId) {
+                m_lastTrainId = trainId;
+                m_trainProgress = now;
+            }
+            if (outputRate > 0) m_outputProgress = now;
+
+            std::vector<int> iobs;
+            std::vector<int> failingIobs;
+            for (const auto & failure : channelFailures) {
+                iobs.push_back(failure.first);
+                if (failure.second == 0) {
+                    m_failingSince.erase(failure.first);
+                } else if (now - m_failingSince.emplace(failure.first, now).first->second >= m_stallTime) {
+                    failingIobs.push_back(failure.first);
+                }
+            }
+
+            const bool trainStall = now - m_trainProgress >= m_stallTime;
+            const bool outputStall = now - m_outputProgress >= m_stallTime;
+            const bool stalled = trainStall || outputStall || !failingIobs.empty();
+
+            switch (m_state) {
+                case State::RECOVERING:
+                    return {StallAction::NONE, {}, ""};
+                case State::GAVE_UP:
+                    if (!stalled) m_state = State::WATCHING;
+                    return {StallAction::NONE, {}, ""};
+                case State::VERIFYING:
+                    // a stall needs the stall time to show up again
+                    if (now - m_recoveryFinished < m_stallTime) return {StallAction::NONE, {}, ""};
+                    if (!stalled) {
+                        m_numRecovered++;
+                        m_lastRecoveryTime = std::chrono::duration_cast<std::chrono::milliseconds>(m_recoveryFinished - m_stallStart).count();
+                        m_state = State::WATCHING;
+                        return {StallAction::NONE, {}, ""};
+                    }
+                    m_numFailedRecoveries++;
+                    m_level++;
+                    break;
+                case State::WATCHING:
+                    if (!stalled) return {StallAction::NONE, {}, ""};
+                    m_numStalls++;
+                    m_stallStart = now;
+                    m_level = 0;
+                    break;
+            }
+
+            StallRecovery recovery;
+            if (trainStall) {
+                recovery = {StallAction::GIVE_UP, {}, "train id stalled"};
+            } else {
+                const StallAction actions[] = {StallAction::AURORA_RESET, StallAction::REINIT_MODULE, StallAction::GIVE_UP};
+                recovery.action = actions[std::min<unsigned int>(m_level, 2)];
+                recovery.iobs = failingIobs.empty() ? iobs : failingIobs;
+                recovery.reason = failingIobs.empty() ? "no data sent" : "failing ASIC channels";
+            }
+            if (recovery.action == StallAction::GIVE_UP) {
+                m_state = State::GAVE_UP;
+            } else {
+                m_state = State::RECOVERING;
+                m_numRecoveries++;
+            }
+            return recovery;
+        }
+
+        // The recovery returned by update() was run, its effect is checked with the next samples
+        void recoveryFinished(Clock::time_point now) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_state != State::RECOVERING) return;
+            m_state = State::VERIFYING;
+            m_recoveryFinished = now;
+            // failures still seen after the recovery count from here
+            for (auto & failing : m_failingSince) failing.second = now;
+            m_outputProgress = now;
+        }
+
+        std::string status() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            switch (m_state) {
+                case State::RECOVERING: return "RECOVERING";
+                case State::VERIFYING: return "VERIFYING";
+                case State::GAVE_UP: return "GAVE_UP";
+                default: return "WATCHING";
+            }
+        }
+
+        uint64_t numStalls() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_numStalls;
+        }
+
+        uint64_t numRecoveries() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_numRecoveries;
+        }
+
+        uint64_t numRecovered() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_numRecovered;
+        }
+
+        uint64_t numFailedRecoveries() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_numFailedRecoveries;
+        }
+
+        // Time from the detection of the last recovered stall to the end of the successful action in ms
+        uint64_t lastRecoveryTime() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_lastRecoveryTime;
+        }
+
+    private:
+
+        enum class State {
+            WATCHING, RECOVERING, VERIFYING, GAVE_UP
+        };
+
+        mutable std::mutex m_mutex;
+        std::chrono::milliseconds m_stallTime;
+        bool m_started;
+        uint64_t m_lastTrainId;
+        Clock::time_point m_trainProgress;
+        Clock::time_point m_outputProgress;
+        std::map<int, Clock::time_point> m_failingSince;
+        State m_state;
+        unsigned int m_level;
+        Clock::time_point m_stallStart;
+        Clock::time_point m_recoveryFinished;
+        uint64_t m_numStalls;
+        uint64_t m_numRecoveries;
+        uint64_t m_numRecovered;
+        uint64_t m_numFailedRecoveries;
+        uint64_t m_lastRecoveryTime;
+    };
+}
+
+#endif
@@ -0,0 +1,110 @@
+/*
+ * File:   DsscTelemetryHistory.hh
+ *
+ * Fixed size history of telemetry samples.
+ */
+
+#ifndef DSSCTELEMETRYHISTORY_HH
+#define DSSCTELEMETRYHISTORY_HH
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace karabo {
+
+    struct TelemetrySample {
+
+        double timestamp; // seconds since epoch
+        uint64_t trainId;
+        int32_t pptTemp;
+        uint32_t ethOutputRate;
+        std::array<int32_t, 4> iobTemp;
+    };
+
+    /**
+     * Ring buffer of the last CAPACITY telemetry samples. One thread (the
+     * telemetry thread) pushes, any number of threads read without taking a
+     * lock: every slot carries a sequence number which is odd while the slot
+     * is written, readers drop samples overwritten while copying them.
+     */
+    class TelemetryHistory {
+
+    public:
+
+        static constexpr size_t CAPACITY = 4096;
+
+        TelemetryHistory() : m_slots(new Slot[CAPACITY]), m_numWritten(0) {
+        }
+
+        // Single writer only
+        void push(const TelemetrySample & sample) {
+            const uint64_t index = m_numWritten.load(std::memory_order_relaxed);
+            Slot & slot = m_slots[index % CAPACITY];
+
+            std::array<uint64_t, WORDS> words{};
+            std::memcpy(words.data(), &sample, sizeof (sample));
+
+            slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (size_t i = 0; i < WORDS; ++i) {
+                slot.words[i].store(words[i], std::memory_order_relaxed);
+            }
+            slot.sequence.store(2 * index + 2, std::memory_order_release);
+            m_numWritten.store(index + 1, std::memory_order_release);
+        }
+
+        // Total number of samples pushed, including the ones overwritten
+        uint64_t numWritten() const {
+            return m_numWritten.load(std::memory_order_acquire);
+        }
+
+        // Up to the last numSamples samples, oldest first
+        std::vector<TelemetrySample> last(size_t numSamples) const {
+            const uint64_t end = numWritten();
+            const uint64_t available = std::min<uint64_t>(end, CAPACITY);
+            const uint64_t begin = end - std::min<uint64_t>(numSamples, available);
+
+            std::vector<TelemetrySample> res;
+            res.reserve(end - begin);
+            for (uint64_t index = begin; index < end; ++index) {
+                const Slot & slot = m_slots[index % CAPACITY];
+                const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+                if (sequence != 2 * index + 2) continue;
+
+                std::array<uint64_t, WORDS> words;
+                for (size_t i = 0; i < WORDS; ++i) {
+                    words[i] = slot.words[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) != sequence) continue;
+
+                TelemetrySample sample;
+                std::memcpy(&sample, words.data(), sizeof (sample));
+                res.push_back(sample);
+            }
+            return res;
+        }
+
+    private:
+
+        static_assert(std::is_trivially_copyable<TelemetrySample>::value, "TelemetrySample is copied bytewise");
+        static constexpr size_t WORDS = (sizeof (TelemetrySample) + sizeof (uint64_t) - 1) / sizeof (uint64_t);
+
+        struct Slot {
+
+            std::atomic<uint64_t> sequence{0};
+            std::array<std::atomic<uint64_t>, WORDS> words{};
+        };
+
+        std::unique_ptr<Slot[]> m_slots;
+        std::atomic<uint64_t> m_numWritten;
+    };
+}
+
+#endif
@@ -0,0 +1,218 @@
+/*
+ * File:   DsscTelemetryScheduler.hh
+ *
+ * Single thread scheduling all periodic telemetry reads of the PPT.
+ */
+
+#ifndef DSSCTELEMETRYSCHEDULER_HH
+#define DSSCTELEMETRYSCHEDULER_HH
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace karabo {
+
+    enum class TelemetryMode {
+        IDLE = 0, ON = 1, ACQUIRING = 2
+    };
+
+    /**
+     * Runs periodic telemetry reads ("metrics") from one thread. Every
+     * metric has an interval depending on the telemetry mode, an interval of
+     * 0 disables the metric in that mode. All metrics falling due together
+     * are handed to the batch function in one call, so that they can be read
+     * under a single PPT lock. A metric is considered due a tenth of its
+     * interval early to let metrics with close deadlines share a batch.
+     *
+     * A metric can also be scheduled for a given time with scheduleAt(),
+     * overriding its interval for the next read.
+     *
+     * Metrics have to be added before start().
+     */
+    class TelemetryScheduler {
+
+    public:
+
+        using Clock = std::chrono::steady_clock;
+        using IntervalFunction = std::function<std::chrono::milliseconds(TelemetryMode)>;
+        using ModeFunction = std::function<TelemetryMode()>;
+        // Returns false if the batch was skipped, e.g. because the PPT was busy
+        using BatchFunction = std::function<bool(const std::vector<std::string> &)>;
+
+        // Longest sleep without re-evaluating mode and intervals
+        static constexpr std::chrono::milliseconds MAX_SLEEP{1000};
+
+        TelemetryScheduler() : m_running(false), m_wake(false), m_numBatches(0), m_numReads(0), m_numSkipped(0) {
+        }
+
+        ~TelemetryScheduler() {
+            stop();
+        }
+
+        void addMetric(const std::string & name, const IntervalFunction & interval) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_metrics.push_back({name, interval, Clock::time_point(), false, Clock::time_point()});
+        }
+
+        void start(const ModeFunction & mode, const BatchFunction & batch) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_running) return;
+            m_mode = mode;
+            m_batch = batch;
+            for (auto & metric : m_metrics) metric.done = false;
+            m_running = true;
+            m_thread = std::thread(&TelemetryScheduler::run, this);
+        }
+
+        // Must not be called from the batch function
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_running) return;
+                m_running = false;
+            }
+            m_wakeUp.notify_all();
+            if (m_thread.joinable()) m_thread.join();
+        }
+
+        bool isRunning() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_running;
+        }
+
+        // Re-evaluates mode and intervals right away, e.g. after a state change
+        void wakeUp() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_wake = true;
+            }
+            m_wakeUp.notify_all();
+        }
+
+        // The next read of name is due at time instead of after its interval
+        void scheduleAt(const std::string & name, Clock::time_point time) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                for (auto & metric : m_metrics) {
+                    if (metric.name == name) metric.deadline = time;
+                }
+            }
+            m_wakeUp.notify_all();
+        }
+
+        // Names of the metrics due at now, empty if none
+        std::vector<std::string> dueMetrics(Clock::time_point now, TelemetryMode mode) const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::vector<std::string> res;
+            for (const auto & metric : m_metrics) {
+                const auto interval = metric.interval(mode);
+                if (interval.count() > 0 && dueAt(metric, interval) <= now) {
+                    res.push_back(metric.name);
+                }
+            }
+            return res;
+        }
+
+        void markDone(const std::vector<std::string> & names, Clock::time_point now) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto & metric : m_metrics) {
+                if (std::find(names.begin(), names.end(), metric.name) != names.end()) {
+                    metric.last = now;
+                    metric.done = true;
+                    // keep a deadline set by the batch function for a later read
+                    if (metric.deadline <= now) metric.deadline = Clock::time_point();
+                }
+            }
+        }
+
+        // Time at which the next metric falls due, at most MAX_SLEEP from now
+        Clock::time_point nextDue(Clock::time_point now, TelemetryMode mode) const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Clock::time_point next = now + MAX_SLEEP;
+            for (const auto & metric : m_metrics) {
+                const auto interval = metric.interval(mode);
+                if (interval.count() > 0) {
+                    next = std::min(next, std::max(now, dueAt(metric, interval)));
+                }
+            }
+            return next;
+        }
+
+        uint64_t numBatches() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_numBatches;
+        }
+
+        uint64_t numReads() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_numReads;
+        }
+
+        uint64_t numSkipped() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_numSkipped;
+        }
+
+    private:
+
+        struct Metric {
+
+            std::string name;
+            IntervalFunction interval;
+            Clock::time_point last;
+            bool done;
+            Clock::time_point deadline; // set by scheduleAt, cleared by the read it schedules
+        };
+
+        static Clock::time_point dueAt(const Metric & metric, std::chrono::milliseconds interval) {
+            if (!metric.done) return Clock::time_point();
+            if (metric.deadline != Clock::time_point()) return metric.deadline;
+            return metric.last + interval - interval / 10;
+        }
+
+        void run() {
+            while (isRunning()) {
+                const TelemetryMode mode = m_mode();
+                const auto now = Clock::now();
+                const auto due = dueMetrics(now, mode);
+                if (!due.empty()) {
+                    // a skipped sample is stale when the PPT is free again, wait for the next one
+                    const bool read = m_batch(due);
+                    markDone(due, now);
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_numBatches++;
+                    m_numReads += due.size();
+                    if (!read) m_numSkipped++;
+                }
+
+                const auto next = nextDue(Clock::now(), m_mode());
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wakeUp.wait_until(lock, next, [this] {
+                    return !m_running || m_wake;
+                });
+                m_wake = false;
+            }
+        }
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_wakeUp;
+        std::vector<Metric> m_metrics;
+        ModeFunction m_mode;
+        BatchFunction m_batch;
+        bool m_running;
+        bool m_wake;
+        std::thread m_thread;
+        uint64_t m_numBatches;
+        uint64_t m_numReads;
+        uint64_t m_numSkipped;
+    };
+}
+
+#endif
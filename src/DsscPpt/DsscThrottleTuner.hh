@@ -0,0 +1,103 @@
+/*
+ * File:   DsscThrottleTuner.hh
+ *
+ * Search of the fastest ethernet throttle divider without frame loss.
+ */
+
+#ifndef DSSCTHROTTLETUNER_HH
+#define DSSCTHROTTLETUNER_HH
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+
+namespace karabo {
+
+    /**
+     * Binary search of the smallest (fastest) throttle divider without
+     * frame loss, between fastest and a divider known to be free of loss.
+     * Frame loss is assumed to only get worse for smaller dividers.
+     */
+    class ThrottleTuner {
+
+    public:
+
+        // Outcome of the test of a divider, aborted tests tell nothing about it
+        enum class Test {
+            NO_LOSS, LOSS, ABORTED
+        };
+
+        ThrottleTuner(uint32_t good, uint32_t fastest = 0) : m_lossy(fastest), m_good(good), m_numTests(0) {
+            // m_lossy is the smallest divider which may still be free of loss
+        }
+
+        bool done() const {
+            return m_lossy >= m_good;
+        }
+
+        // Divider to test next, only valid if not done()
+        uint32_t next() const {
+            return m_lossy + (m_good - m_lossy) / 2;
+        }
+
+        // Result of the test of next()
+        void report(bool loss) {
+            const uint32_t tested = next();
+            if (loss) {
+                m_lossy = tested + 1;
+            } else {
+                m_good = tested;
+            }
+            m_numTests++;
+        }
+
+        // Fastest divider found without loss
+        uint32_t result() const {
+            return m_good;
+        }
+
+        unsigned int numTests() const {
+            return m_numTests;
+        }
+
+        // Tests needed at most to search between good and fastest
+        static unsigned int maxTests(uint32_t good, uint32_t fastest = 0) {
+            unsigned int res = 0;
+            for (uint32_t range = good - fastest; range > 0; range /= 2) res++;
+            return res;
+        }
+
+        // Tuned dividers per receiver configuration, stored as "configuration=divider" lines
+        static std::map<std::string, uint32_t> load(const std::string & fileName) {
+            std::map<std::string, uint32_t> res;
+            std::ifstream in(fileName);
+            std::string line;
+            while (std::getline(in, line)) {
+                const size_t pos = line.rfind('=');
+                if (pos == std::string::npos) continue;
+                try {
+                    res[line.substr(0, pos)] = std::stoul(line.substr(pos + 1));
+                } catch (...) {
+                }
+            }
+            return res;
+        }
+
+        static bool save(const std::string & fileName, const std::map<std::string, uint32_t> & dividers) {
+            std::ofstream out(fileName);
+            for (const auto & entry : dividers) {
+                out << entry.first << "=" << entry.second << "\n";
+            }
+            return static_cast<bool> (out);
+        }
+
+    private:
+
+        uint32_t m_lossy;
+        uint32_t m_good;
+        unsigned int m_numTests;
+    };
+}
+
+#endif
@@ -0,0 +1,163 @@
+/*
+ * File:   DsscThroughputMeter.hh
+ *
+ * Output throughput of the four QSFP channels compared to the expected rate.
+ */
+
+#ifndef DSSCTHROUGHPUTMETER_HH
+#define DSSCTHROUGHPUTMETER_HH
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+namespace karabo {
+
+    struct ChannelThroughput {
+
+        double rate; // MBit/s
+        double expectedRate; // MBit/s
+        double deficit; // percent of the expected rate
+        double congestion; // fraction of the samples with full fifos or link down
+        bool belowExpected;
+    };
+
+    /**
+     * Meters the output of the QSFP channels over a sliding window.
+     *
+     * The PPT only measures the rate of all channels together, per channel
+     * it reports full output fifos and the PCS block lock. The deficit of
+     * the measured rate against the expected rate of all channels is
+     * therefore attributed to the channels in proportion to their
+     * congestion, the fraction of samples with full fifos or no link. A
+     * channel without congestion gets no deficit, without any congestion the
+     * deficit is only reported by total().
+     */
+    class ThroughputMeter {
+
+    public:
+
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t NUM_CHANNELS = 4;
+
+        // Expected output of one channel in MBit/s for 16 bit pixels at 10 trains/s
+        static double expectedChannelRate(unsigned int numFrames, unsigned int numSendingAsics) {
+            return numFrames * 4096.0 * numSendingAsics * 2 * 8 * 10 / 1E6;
+        }
+
+        ThroughputMeter() : m_window(10), m_threshold(10.0) {
+        }
+
+        void setWindow(std::chrono::seconds window) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_window = window;
+        }
+
+        // Deficit in percent from which a channel is below expected
+        void setThreshold(double threshold) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_threshold = threshold;
+        }
+
+        void reset() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_samples.clear();
+        }
+
+        void addSample(Clock::time_point time, double totalRate, const std::array<bool, NUM_CHANNELS> & congested) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_samples.push_back({time, totalRate, congested});
+            while (time - m_samples.front().time > m_window) {
+                m_samples.pop_front();
+            }
+        }
+
+        // Throughput per channel over the window ending at now, channels with expected rate 0 are inactive
+        std::array<ChannelThroughput, NUM_CHANNELS> throughput(Clock::time_point now,
+                                                               const std::array<double, NUM_CHANNELS> & expectedRates) const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::array<ChannelThroughput, NUM_CHANNELS> res{};
+            double totalRate = 0;
+            size_t numSamples = 0;
+            for (const auto & sample : m_samples) {
+                if (now - sample.time > m_window) continue;
+                totalRate += sample.totalRate;
+                numSamples++;
+                for (size_t ch = 0; ch < NUM_CHANNELS; ++ch) {
+                    if (sample.congested[ch]) res[ch].congestion += 1;
+                }
+            }
+            if (numSamples == 0) return res;
+            totalRate /= numSamples;
+
+            double expectedTotal = 0;
+            double congestionTotal = 0;
+            for (size_t ch = 0; ch < NUM_CHANNELS; ++ch) {
+                res[ch].congestion /= numSamples;
+                res[ch].expectedRate = expectedRates[ch];
+                if (expectedRates[ch] <= 0) continue;
+                expectedTotal += expectedRates[ch];
+                congestionTotal += res[ch].congestion;
+            }
+
+            const double deficit = std::max(0.0, expectedTotal - totalRate);
+            for (size_t ch = 0; ch < NUM_CHANNELS; ++ch) {
+                auto & channel = res[ch];
+                if (channel.expectedRate <= 0) continue;
+                const double share = (congestionTotal > 0) ? channel.congestion / congestionTotal : 0.0;
+                const double channelDeficit = std::min(channel.expectedRate, deficit * share);
+                channel.rate = channel.expectedRate - channelDeficit;
+                channel.deficit = 100 * channelDeficit / channel.expectedRate;
+                channel.belowExpected = channel.deficit > m_threshold;
+            }
+            return res;
+        }
+
+        // Throughput of all active channels together, congestion is the fraction of samples with any channel congested
+        ChannelThroughput total(Clock::time_point now, const std::array<double, NUM_CHANNELS> & expectedRates) const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ChannelThroughput res{};
+            size_t numSamples = 0;
+            for (const auto & sample : m_samples) {
+                if (now - sample.time > m_window) continue;
+                res.rate += sample.totalRate;
+                if (std::find(sample.congested.begin(), sample.congested.end(), true) != sample.congested.end()) {
+                    res.congestion += 1;
+                }
+                numSamples++;
+            }
+            if (numSamples == 0) return res;
+            res.rate /= numSamples;
+            res.congestion /= numSamples;
+
+            for (double expectedRate : expectedRates) {
+                res.expectedRate += std::max(0.0, expectedRate);
+            }
+            if (res.expectedRate > 0) {
+                res.deficit = 100 * std::max(0.0, res.expectedRate - res.rate) / res.expectedRate;
+                res.belowExpected = res.deficit > m_threshold;
+            }
+            return res;
+        }
+
+    private:
+
+        struct Sample {
+
+            Clock::time_point time;
+            double totalRate;
+            std::array<bool, NUM_CHANNELS> congested;
+        };
+
+        mutable std::mutex m_mutex;
+        std::chrono::seconds m_window;
+        double m_threshold;
+        std::deque<Sample> m_samples;
+    };
+}
+
+#endif
@@ -0,0 +1,124 @@
+/*
+ * File:   DsscTrainIdTracker.hh
+ *
+ * Model of the train clock used to predict the arrival of train ids.
+ */
+
+#ifndef DSSCTRAINIDTRACKER_HH
+#define DSSCTRAINIDTRACKER_HH
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+
+namespace karabo {
+
+    /**
+     * Predicts when a train id will be seen from a few train id reads.
+     *
+     * Two reads of consecutive train ids bracket the train edge, the middle
+     * of both reads is taken as the edge time. The edges are fitted by a
+     * straight line; the train period is the nominal one (10 Hz) until the
+     * edges span MIN_FIT_SPAN trains. Reads that do not match the model
+     * (e.g. after a train id reset) drop all edges.
+     */
+    class TrainIdTracker {
+
+    public:
+
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t MAX_EDGES = 32;
+        static constexpr size_t MIN_EDGES = 2;
+        static constexpr uint64_t MIN_FIT_SPAN = 10;
+
+        explicit TrainIdTracker(std::chrono::microseconds nominalPeriod = std::chrono::microseconds(100000))
+            : m_nominalPeriod(nominalPeriod), m_hasLast(false), m_lastId(0) {
+        }
+
+        void reset() {
+            m_edges.clear();
+            m_hasLast = false;
+        }
+
+        void addSample(Clock::time_point time, uint64_t trainId) {
+            if (m_hasLast && trainId < m_lastId) {
+                m_edges.clear();
+            } else if (isReady()) {
+                // one train off is a read close to an edge, more is a jump of the clock
+                const uint64_t predicted = predictTrainId(time);
+                if (trainId > predicted + 1 || trainId + 1 < predicted) m_edges.clear();
+            }
+            if (m_hasLast && trainId == m_lastId + 1) {
+                m_edges.push_back({m_lastTime + (time - m_lastTime) / 2, trainId});
+                if (m_edges.size() > MAX_EDGES) m_edges.pop_front();
+            }
+            m_hasLast = true;
+            m_lastTime = time;
+            m_lastId = trainId;
+        }
+
+        bool isReady() const {
+            return m_edges.size() >= MIN_EDGES;
+        }
+
+        // Train period in seconds
+        double period() const {
+            if (m_edges.size() < 2 || m_edges.back().trainId - m_edges.front().trainId < MIN_FIT_SPAN) {
+                return std::chrono::duration<double>(m_nominalPeriod).count();
+            }
+            // least squares slope of edge time over train id
+            const auto t0 = m_edges.front().time;
+            const double id0 = m_edges.front().trainId;
+            double sumX = 0, sumY = 0, sumXX = 0, sumXY = 0;
+            for (const auto & edge : m_edges) {
+                const double x = edge.trainId - id0;
+                const double y = std::chrono::duration<double>(edge.time - t0).count();
+                sumX += x;
+                sumY += y;
+                sumXX += x * x;
+                sumXY += x * y;
+            }
+            const double n = m_edges.size();
+            return (n * sumXY - sumX * sumY) / (n * sumXX - sumX * sumX);
+        }
+
+        // Time at which trainId starts, only meaningful if isReady()
+        Clock::time_point predictArrival(uint64_t trainId) const {
+            const double p = period();
+            const auto t0 = m_edges.front().time;
+            const double id0 = m_edges.front().trainId;
+            // intercept such that the line passes through the mean of all edges
+            double meanOffset = 0;
+            for (const auto & edge : m_edges) {
+                meanOffset += std::chrono::duration<double>(edge.time - t0).count() - p * (edge.trainId - id0);
+            }
+            meanOffset /= m_edges.size();
+            const double seconds = meanOffset + p * (static_cast<double> (trainId) - id0);
+            return t0 + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+        }
+
+        // Train id expected at time, only meaningful if isReady()
+        uint64_t predictTrainId(Clock::time_point time) const {
+            const uint64_t id = m_edges.back().trainId;
+            const double trains = std::chrono::duration<double>(time - predictArrival(id)).count() / period();
+            return (trains < 0) ? id - static_cast<uint64_t> (-trains + 1.0) : id + static_cast<uint64_t> (trains);
+        }
+
+    private:
+
+        struct Edge {
+
+            Clock::time_point time;
+            uint64_t trainId;
+        };
+
+        std::chrono::microseconds m_nominalPeriod;
+        std::deque<Edge> m_edges;
+        bool m_hasLast;
+        Clock::time_point m_lastTime;
+        uint64_t m_lastId;
+    };
+}
+
+#endif
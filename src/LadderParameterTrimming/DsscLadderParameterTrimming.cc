@@ -432,6 +432,12 @@ namespace karabo{
                 .description("Fill Sram And Readout Pattern")
                 .commit();
 
+        SLOT_ELEMENT(expected)
+                .key("abortOperation")
+                .displayedName("Abort Operation")
+                .description("Abort a running SRAM fill and readout sequence after its current step, also aborts the operation running on the PPT device")
+                .commit();
+
         SLOT_ELEMENT(expected)
                 .key("matrixSRAMTest")
                 .displayedName("MatrixSRAMTest")
@@ -815,7 +821,8 @@ namespace karabo{
         m_asicMeanValues(utils::s_totalNumPxs),
         m_pixelData(utils::s_totalNumPxs*utils::s_numSram),
         m_currentTrimmer(nullptr),
-        m_deviceInitialized(false) {
+        m_deviceInitialized(false),
+        m_abortRequested(false) {
         KARABO_INITIAL_FUNCTION(initialization)
 
         KARABO_SLOT(measureBurstData);
@@ -823,6 +830,7 @@ namespace karabo{
         KARABO_SLOT(setBaseline);
         KARABO_SLOT(clearBaseline);
         KARABO_SLOT(fillSramAndReadoutPattern);
+        KARABO_SLOT(abortOperation);
         KARABO_SLOT(matrixSRAMTest);
         KARABO_SLOT(runPixelDelayTrimming);
         KARABO_SLOT(runGainTrimming);
@@ -2578,13 +2586,23 @@ void DsscLadderParameterTrimming::waitJTAGEngineDone() {
             return false;
         }
 
+        // every PPT call takes a while, check for an abort before each of them
         if (init) {
+            if (m_abortRequested) {
+                KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " fillSramAndReadout aborted";
+                return false;
+            }
             remote().set<unsigned short>(m_pptDeviceId, "sramPattern", 0);
             runContinuousMode(false);
             // takes a while to program the whole ladder
             remote().execute(m_pptDeviceId, "fillSramAndReadout", 600);
         }
 
+        if (m_abortRequested) {
+            KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " fillSramAndReadout aborted";
+            return false;
+        }
+
         remote().set<unsigned short>(m_pptDeviceId, "sramPattern", pattern);
 
         runContinuousMode(false);
@@ -2600,10 +2618,20 @@ void DsscLadderParameterTrimming::waitJTAGEngineDone() {
 
     void DsscLadderParameterTrimming::fillSramAndReadoutPattern() {
         const auto pattern = get<unsigned short>("sramPattern");
+        m_abortRequested = false;
         fillSramAndReadout(pattern, true);
     }
 
 
+    void DsscLadderParameterTrimming::abortOperation() {
+        KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " Abort requested";
+        m_abortRequested = true;
+        if (isDeviceExisting(m_pptDeviceId)) {
+            remote().executeNoWait(m_pptDeviceId, "abortOperation");
+        }
+    }
+
+
     void DsscLadderParameterTrimming::powerUpSelPixels() {
         m_trimppt_api->powerDownPixels("all");
         const auto pixels = getPixelsToChange();
@@ -3184,7 +3212,12 @@ void DsscLadderParameterTrimming::waitJTAGEngineDone() {
     void DsscLadderParameterTrimming::sramTest(int iterations, bool init) {
         const std::string baseDir = get<string>("outputDir");
 
+        m_abortRequested = false;
         for (int i = 0; i < iterations; i++) {
+            if (m_abortRequested) {
+                KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " sramTest aborted after " << i << " iterations";
+                break;
+            }
             const std::string runDir = baseDir + "/RUN" + to_string(i);
             utils::makePath(runDir);
             set<string>("outputDir", runDir);
@@ -3194,6 +3227,10 @@ void DsscLadderParameterTrimming::waitJTAGEngineDone() {
                 runContinuousMode(false);
                 // takes a while to program the whole ladder
                 remote().execute(m_pptDeviceId, "fillSramAndReadout", 600);
+                if (m_abortRequested) {
+                    KARABO_LOG_FRAMEWORK_WARN << getInstanceId() << " sramTest aborted after " << i << " iterations";
+                    break;
+                }
             }
             matrixSRAMTest();
         }
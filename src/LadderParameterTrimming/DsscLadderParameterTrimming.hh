@@ -12,6 +12,8 @@
  
 #include <karabo/karabo.hpp>
 
+#include <atomic>
+
 #include "CHIPTrimmer.h"
 #include "DsscHDF5MeasurementInfoWriter.h"
 #include "DsscHDF5CalibrationDataGenerator.h"
@@ -354,6 +356,7 @@ namespace karabo {
         void startPptDevice();
         void triggerPptInitFunction(data::State originState, const std::string & function, int timeout = 3, int TRY_CNT = 3);
         void fillSramAndReadoutPattern();
+        void abortOperation();
 
         void computeTargetGainADCConfiguration();
 
@@ -439,6 +442,8 @@ namespace karabo {
         DsscHDF5CalibrationDataGenerator m_calibGenerator;
 
         bool m_deviceInitialized;
+        // set by abortOperation, checked between the steps of long SRAM sequences
+        std::atomic<bool> m_abortRequested;
 
         void changeDeviceState(const data::State & newState);
 
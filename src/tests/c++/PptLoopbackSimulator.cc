@@ -0,0 +1,436 @@
+/*
+ * File:   PptLoopbackSimulator.cc
+ *
+ * Local TCP stand-in for the PPT used by the tests and benchmarks.
+ */
+
+#include "PptLoopbackSimulator.hh"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+namespace DSSC {
+
+    namespace {
+
+        bool sendAll(int fd, const char * data, size_t size) {
+            size_t sent = 0;
+            while (sent < size) {
+                ssize_t rc = ::send(fd, data + sent, size - sent, MSG_NOSIGNAL);
+                if (rc <= 0) return false;
+                sent += rc;
+            }
+            return true;
+        }
+
+        bool recvAll(int fd, char * data, size_t size) {
+            size_t received = 0;
+            while (received < size) {
+                ssize_t rc = ::recv(fd, data + received, size - received, 0);
+                if (rc <= 0) return false;
+                received += rc;
+            }
+            return true;
+        }
+
+        int connectTo(const string & host, unsigned int port) {
+            addrinfo hints{};
+            hints.ai_family = AF_INET;
+            hints.ai_socktype = SOCK_STREAM;
+            addrinfo * addresses = nullptr;
+            if (getaddrinfo(host.c_str(), to_string(port).c_str(), &hints, &addresses) != 0) return -1;
+
+            int fd = -1;
+            for (addrinfo * addr = addresses; addr != nullptr; addr = addr->ai_next) {
+                fd = ::socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+                if (fd < 0) continue;
+                if (::connect(fd, addr->ai_addr, addr->ai_addrlen) == 0) break;
+                ::close(fd);
+                fd = -1;
+            }
+            freeaddrinfo(addresses);
+            if (fd >= 0) {
+                int nodelay = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof (nodelay));
+            }
+            return fd;
+        }
+
+        string toHex(const string & data) {
+            static const char digits[] = "0123456789abcdef";
+            string res;
+            res.reserve(2 * data.size());
+            for (unsigned char c : data) {
+                res += digits[c >> 4];
+                res += digits[c & 0xF];
+            }
+            return res;
+        }
+
+        bool fromHex(const string & hex, string & data) {
+            if (hex.size() % 2 != 0) return false;
+            data.clear();
+            for (size_t i = 0; i < hex.size(); i += 2) {
+                const string byte = hex.substr(i, 2);
+                if (byte.find_first_not_of("0123456789abcdefABCDEF") != string::npos) return false;
+                data += static_cast<char> (stoi(byte, nullptr, 16));
+            }
+            return true;
+        }
+    }
+
+
+    PptLoopbackSimulator::PptLoopbackSimulator()
+        : m_running(false), m_listenFd(-1), m_port(0),
+          m_latency(0), m_jitter(0), m_rng(2384), m_upstreamPort(0),
+          m_numRequests(0), m_numUnmatched(0), m_numConnections(0) {
+    }
+
+
+    PptLoopbackSimulator::~PptLoopbackSimulator() {
+        stop();
+    }
+
+
+    unsigned int PptLoopbackSimulator::start(unsigned int port) {
+        if (m_running) return m_port;
+
+        m_listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (m_listenFd < 0) return 0;
+
+        int reuse = 1;
+        setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof (reuse));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(port);
+        if (::bind(m_listenFd, reinterpret_cast<sockaddr *> (&addr), sizeof (addr)) < 0 ||
+            ::listen(m_listenFd, 4) < 0) {
+            ::close(m_listenFd);
+            m_listenFd = -1;
+            return 0;
+        }
+
+        socklen_t len = sizeof (addr);
+        getsockname(m_listenFd, reinterpret_cast<sockaddr *> (&addr), &len);
+        m_port = ntohs(addr.sin_port);
+
+        m_running = true;
+        m_acceptThread = thread(&PptLoopbackSimulator::acceptLoop, this);
+        return m_port;
+    }
+
+
+    void PptLoopbackSimulator::stop() {
+        if (!m_running) return;
+        m_running = false;
+
+        ::shutdown(m_listenFd, SHUT_RDWR);
+        ::close(m_listenFd);
+        m_listenFd = -1;
+        if (m_acceptThread.joinable()) m_acceptThread.join();
+
+        list<unique_ptr<Client>> clients;
+        {
+            lock_guard<mutex> lock(m_clientMutex);
+            clients.swap(m_clients);
+        }
+        // the sockets are still open, their threads only return once they were shut down
+        for (auto & client : clients) ::shutdown(client->fd, SHUT_RDWR);
+        for (auto & client : clients) {
+            if (client->thread.joinable()) client->thread.join();
+            ::close(client->fd);
+        }
+    }
+
+
+    void PptLoopbackSimulator::setLatency(chrono::microseconds latency, chrono::microseconds jitter) {
+        lock_guard<mutex> lock(m_configMutex);
+        m_latency = latency;
+        m_jitter = jitter;
+    }
+
+
+    void PptLoopbackSimulator::setSession(const Session & session) {
+        lock_guard<mutex> lock(m_sessionMutex);
+        m_session = session;
+    }
+
+
+    void PptLoopbackSimulator::setUpstream(const string & host, unsigned int port) {
+        lock_guard<mutex> lock(m_configMutex);
+        m_upstreamHost = host;
+        m_upstreamPort = port;
+    }
+
+
+    PptLoopbackSimulator::Session PptLoopbackSimulator::recordedSession() {
+        lock_guard<mutex> lock(m_sessionMutex);
+        return m_session;
+    }
+
+
+    bool PptLoopbackSimulator::loadCapture(const string & fileName, Session & session) {
+        ifstream in(fileName);
+        if (!in) return false;
+
+        session.clear();
+        string line;
+        while (getline(in, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            istringstream fields(line);
+            size_t connection;
+            string direction, hex;
+            if (!(fields >> connection >> direction >> hex) || (direction != ">" && direction != "<")) return false;
+
+            Segment segment{direction == ">", ""};
+            if (!fromHex(hex, segment.data)) return false;
+            if (session.size() <= connection) session.resize(connection + 1);
+            session[connection].push_back(std::move(segment));
+        }
+        return true;
+    }
+
+
+    bool PptLoopbackSimulator::saveCapture(const string & fileName, const Session & session) {
+        ofstream out(fileName);
+        for (size_t connection = 0; connection < session.size(); ++connection) {
+            for (const auto & segment : session[connection]) {
+                out << connection << (segment.fromClient ? " > " : " < ") << toHex(segment.data) << "\n";
+            }
+        }
+        return static_cast<bool> (out);
+    }
+
+
+    size_t PptLoopbackSimulator::numClients() {
+        reapClients();
+        lock_guard<mutex> lock(m_clientMutex);
+        return m_clients.size();
+    }
+
+
+    void PptLoopbackSimulator::acceptLoop() {
+        while (m_running) {
+            int fd = ::accept(m_listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                if (!m_running) break;
+                continue;
+            }
+            int nodelay = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof (nodelay));
+
+            reapClients();
+
+            auto client = make_unique<Client>();
+            client->fd = fd;
+            client->connection = m_numConnections++;
+            Client & ref = *client;
+            lock_guard<mutex> lock(m_clientMutex);
+            m_clients.push_back(std::move(client));
+            ref.thread = thread(&PptLoopbackSimulator::serveClient, this, std::ref(ref));
+        }
+    }
+
+
+    void PptLoopbackSimulator::reapClients() {
+        list<unique_ptr<Client>> finished;
+        {
+            lock_guard<mutex> lock(m_clientMutex);
+            for (auto it = m_clients.begin(); it != m_clients.end();) {
+                if ((*it)->done) {
+                    finished.push_back(std::move(*it));
+                    it = m_clients.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        for (auto & client : finished) {
+            client->thread.join();
+            ::close(client->fd);
+        }
+    }
+
+
+    void PptLoopbackSimulator::serveClient(Client & client) {
+        bool recording;
+        {
+            lock_guard<mutex> lock(m_configMutex);
+            recording = !m_upstreamHost.empty();
+        }
+        if (recording) {
+            record(client);
+        } else {
+            replay(client);
+        }
+        client.done = true;
+    }
+
+
+    void PptLoopbackSimulator::replay(Client & client) {
+        Conversation conversation;
+        {
+            lock_guard<mutex> lock(m_sessionMutex);
+            if (client.connection < m_session.size()) conversation = m_session[client.connection];
+        }
+
+        size_t next = 0;
+        const auto sendReplies = [&]() {
+            while (next < conversation.size() && !conversation[next].fromClient) {
+                applyLatency();
+                const auto & reply = conversation[next++].data;
+                if (!sendAll(client.fd, reply.data(), reply.size())) return false;
+            }
+            return true;
+        };
+        // requests are matched as a whole, buffer a prefix until it is complete
+        const auto matches = [](const string & buffer, const Segment & segment) {
+            if (!segment.fromClient) return false;
+            const size_t size = min(buffer.size(), segment.data.size());
+            return buffer.compare(0, size, segment.data, 0, size) == 0;
+        };
+
+        // the PPT may talk first
+        if (!sendReplies()) return;
+
+        string buffer;
+        char chunk[4096];
+        while (m_running) {
+            ssize_t rc = ::recv(client.fd, chunk, sizeof (chunk), 0);
+            if (rc <= 0) break;
+            buffer.append(chunk, rc);
+
+            while (!buffer.empty()) {
+                if (next >= conversation.size() || !matches(buffer, conversation[next])) {
+                    // requests repeated a different number of times than recorded, e.g. polling,
+                    // continue from the next recorded occurrence, searching from the start last
+                    size_t found = conversation.size();
+                    for (size_t i = 0; i < conversation.size() && found == conversation.size(); ++i) {
+                        const size_t candidate = (next + 1 + i) % conversation.size();
+                        if (matches(buffer, conversation[candidate])) found = candidate;
+                    }
+                    if (found == conversation.size()) {
+                        ++m_numUnmatched;
+                        buffer.clear();
+                        break;
+                    }
+                    next = found;
+                }
+
+                const auto & request = conversation[next].data;
+                if (buffer.size() < request.size()) break;
+                buffer.erase(0, request.size());
+                ++next;
+                ++m_numRequests;
+                if (!sendReplies()) return;
+            }
+        }
+    }
+
+
+    void PptLoopbackSimulator::record(Client & client) {
+        string host;
+        unsigned int port;
+        {
+            lock_guard<mutex> lock(m_configMutex);
+            host = m_upstreamHost;
+            port = m_upstreamPort;
+        }
+        const int upstream = connectTo(host, port);
+        if (upstream < 0) return;
+
+        {
+            lock_guard<mutex> lock(m_sessionMutex);
+            if (m_session.size() <= client.connection) m_session.resize(client.connection + 1);
+            m_session[client.connection].clear();
+        }
+
+        pollfd fds[2] = {{client.fd, POLLIN, 0}, {upstream, POLLIN, 0}};
+        char chunk[4096];
+        bool open = true;
+        while (m_running && open) {
+            const int rc = ::poll(fds, 2, 100);
+            if (rc < 0) break;
+            for (int i = 0; i < 2 && open; ++i) {
+                if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+                const ssize_t size = ::recv(fds[i].fd, chunk, sizeof (chunk), 0);
+                const bool fromClient = (i == 0);
+                if (size <= 0 || !sendAll(fds[1 - i].fd, chunk, size)) {
+                    open = false;
+                    break;
+                }
+
+                lock_guard<mutex> lock(m_sessionMutex);
+                auto & conversation = m_session[client.connection];
+                if (conversation.empty() || conversation.back().fromClient != fromClient) {
+                    conversation.push_back(Segment{fromClient, ""});
+                    if (fromClient) ++m_numRequests;
+                }
+                conversation.back().data.append(chunk, size);
+            }
+        }
+        ::close(upstream);
+    }
+
+
+    void PptLoopbackSimulator::applyLatency() {
+        chrono::microseconds delay;
+        {
+            lock_guard<mutex> lock(m_configMutex);
+            delay = m_latency;
+            if (m_jitter.count() > 0) {
+                uniform_int_distribution<long> dist(0, m_jitter.count());
+                delay += chrono::microseconds(dist(m_rng));
+            }
+        }
+        if (delay.count() > 0) this_thread::sleep_for(delay);
+    }
+
+
+    PptLoopbackClient::PptLoopbackClient() : m_fd(-1) {
+    }
+
+
+    PptLoopbackClient::~PptLoopbackClient() {
+        disconnect();
+    }
+
+
+    bool PptLoopbackClient::connect(unsigned int port, const string & host) {
+        disconnect();
+        m_fd = connectTo(host, port);
+        return m_fd >= 0;
+    }
+
+
+    void PptLoopbackClient::disconnect() {
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+
+    bool PptLoopbackClient::send(const string & data) {
+        return m_fd >= 0 && sendAll(m_fd, data.data(), data.size());
+    }
+
+
+    bool PptLoopbackClient::receive(size_t size, string & data) {
+        if (m_fd < 0) return false;
+        data.resize(size);
+        return recvAll(m_fd, data.data(), size);
+    }
+}
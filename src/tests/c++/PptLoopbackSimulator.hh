@@ -0,0 +1,136 @@
+/*
+ * File:   PptLoopbackSimulator.hh
+ *
+ * Local TCP stand-in for the PPT used by the tests and benchmarks.
+ *
+ * The PPT wire format is owned by the DsscDependencies library, so the
+ * simulator does not model it. It replays sessions recorded against a real
+ * PPT instead: in recording mode it forwards every connection to the PPT and
+ * keeps the bytes exchanged, in replay mode it answers every request of a
+ * connection with the reply recorded for it, after a configurable latency
+ * plus uniformly distributed jitter.
+ */
+
+#ifndef PPTLOOPBACKSIMULATOR_HH
+#define PPTLOOPBACKSIMULATOR_HH
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace DSSC {
+
+    class PptLoopbackSimulator {
+    public:
+
+        // Bytes sent in one direction until the other side answered
+        struct Segment {
+
+            bool fromClient;
+            std::string data;
+
+            bool operator==(const Segment & other) const {
+                return fromClient == other.fromClient && data == other.data;
+            }
+        };
+
+        // Segments of one connection in the order they were sent
+        using Conversation = std::vector<Segment>;
+        // Conversations of all connections in the order they were opened
+        using Session = std::vector<Conversation>;
+
+        PptLoopbackSimulator();
+        ~PptLoopbackSimulator();
+
+        // Binds to 127.0.0.1:port (0 selects a free port) and starts serving.
+        // Returns the port actually bound, 0 on failure.
+        unsigned int start(unsigned int port = 0);
+        void stop();
+
+        unsigned int port() const { return m_port; }
+
+        void setLatency(std::chrono::microseconds latency, std::chrono::microseconds jitter);
+
+        // Replays the session, the n-th connection opened gets the n-th conversation
+        void setSession(const Session & session);
+        // Records the session by forwarding every connection to the PPT at host:port
+        void setUpstream(const std::string & host, unsigned int port);
+        Session recordedSession();
+
+        // Capture file: one segment per line, "<connection> > <hex>" from the client, "<connection> < <hex>" from the PPT
+        static bool loadCapture(const std::string & fileName, Session & session);
+        static bool saveCapture(const std::string & fileName, const Session & session);
+
+        uint64_t numRequests() const { return m_numRequests; }
+        uint64_t numUnmatched() const { return m_numUnmatched; }
+        uint64_t numConnections() const { return m_numConnections; }
+        // Connections still open, finished ones are reaped first
+        size_t numClients();
+
+    private:
+
+        // Every client owns its socket, it is closed once its thread was joined
+        struct Client {
+
+            int fd = -1;
+            size_t connection = 0;
+            std::thread thread;
+            std::atomic<bool> done{false};
+        };
+
+        void acceptLoop();
+        void reapClients();
+        void serveClient(Client & client);
+        void replay(Client & client);
+        void record(Client & client);
+        void applyLatency();
+
+        std::atomic<bool> m_running;
+        int m_listenFd;
+        unsigned int m_port;
+        std::thread m_acceptThread;
+        std::list<std::unique_ptr<Client>> m_clients;
+        std::mutex m_clientMutex;
+
+        std::mutex m_configMutex;
+        std::chrono::microseconds m_latency;
+        std::chrono::microseconds m_jitter;
+        std::mt19937 m_rng;
+        std::string m_upstreamHost;
+        unsigned int m_upstreamPort;
+
+        std::mutex m_sessionMutex;
+        Session m_session;
+
+        std::atomic<uint64_t> m_numRequests;
+        std::atomic<uint64_t> m_numUnmatched;
+        std::atomic<uint64_t> m_numConnections;
+    };
+
+    // Minimal blocking client sending and receiving raw bytes.
+    class PptLoopbackClient {
+    public:
+
+        PptLoopbackClient();
+        ~PptLoopbackClient();
+
+        bool connect(unsigned int port, const std::string & host = "127.0.0.1");
+        void disconnect();
+
+        bool send(const std::string & data);
+        bool receive(size_t size, std::string & data);
+
+    private:
+
+        int m_fd;
+    };
+}
+
+#endif
@@ -0,0 +1,197 @@
+/*
+ * Benchmarks the DsscPpt device against the loopback PPT simulator.
+ *
+ * Every test drives a programming path of the real device through its slots
+ * and reports the wall clock time via RecordProperty, so the numbers end up
+ * in the gtest XML output (--gtest_output=xml) and can be compared between
+ * builds.
+ *
+ * The simulator replays a session recorded against a real PPT, one capture
+ * file per test in DSSC_SIM_CAPTURE_DIR (default: ConfigFiles/captures). With
+ * DSSC_SIM_PPT_HOST (and DSSC_SIM_PPT_PORT, default 2384) set, the tests run
+ * against that PPT instead and record the captures. Latency and jitter of the
+ * replay are configurable through DSSC_SIM_LATENCY_US and DSSC_SIM_JITTER_US.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+#include "PptLoopbackSimulator.hh"
+
+#include "karabo/core/DeviceClient.hh"
+#include "karabo/core/DeviceServer.hh"
+#include "karabo/net/EventLoop.hh"
+#include "karabo/data/types/Hash.hh"
+#include "karabo/util/PluginLoader.hh"
+
+
+#define DEVICE_SERVER_ID "benchDeviceSrvCpp"
+#define TEST_DEVICE_ID   "benchDsscPpt"
+#define LOG_PRIORITY     "ERROR"
+
+#define DEV_CLI_TIMEOUT_SEC 2
+#define SLOT_TIMEOUT_SEC    600
+
+
+/**
+ * @brief Fixture running a DsscPpt device connected to the loopback simulator.
+ */
+class DsscPptBenchFixture: public testing::Test {
+protected:
+
+    DsscPptBenchFixture() = default;
+
+    void SetUp( ) {
+        const char* pptHost = std::getenv("DSSC_SIM_PPT_HOST");
+        m_recording = (pptHost != nullptr);
+        if (m_recording) {
+            m_sim.setUpstream(pptHost, envValue("DSSC_SIM_PPT_PORT", 2384));
+        } else {
+            DSSC::PptLoopbackSimulator::Session session;
+            if (!DSSC::PptLoopbackSimulator::loadCapture(captureFileName(), session)) {
+                GTEST_SKIP() << "No PPT session recorded in " << captureFileName()
+                             << ", set DSSC_SIM_PPT_HOST to record one";
+            }
+            m_sim.setSession(session);
+            m_sim.setLatency(std::chrono::microseconds(envValue("DSSC_SIM_LATENCY_US", 200)),
+                             std::chrono::microseconds(envValue("DSSC_SIM_JITTER_US", 50)));
+        }
+        m_simPort = m_sim.start();
+        ASSERT_NE(m_simPort, 0u) << "Could not start loopback PPT simulator";
+
+        m_eventLoopThread = std::thread(&karabo::net::EventLoop::work);
+
+        const karabo::data::Hash& pluginConfig = karabo::data::Hash("pluginDirectory", ".");
+        karabo::util::PluginLoader::create("PluginLoader", pluginConfig)->update();
+
+        karabo::data::Hash config("serverId", DEVICE_SERVER_ID,"log.level", LOG_PRIORITY);
+        m_deviceSrv = karabo::core::DeviceServer::create("DeviceServer", config);
+        m_deviceSrv->finalizeInternalInitialization();
+        m_deviceCli = std::make_shared<karabo::core::DeviceClient>();
+    }
+
+    void TearDown( ) {
+        if (!m_deviceCli) return;  // skipped
+        m_deviceCli->killDevice(TEST_DEVICE_ID, DEV_CLI_TIMEOUT_SEC);
+        m_deviceCli.reset();
+        m_deviceSrv.reset();
+        karabo::net::EventLoop::stop();
+        m_eventLoopThread.join();
+        m_sim.stop();
+        if (m_recording) {
+            std::filesystem::create_directories(std::filesystem::path(captureFileName()).parent_path());
+            EXPECT_TRUE(DSSC::PptLoopbackSimulator::saveCapture(captureFileName(), m_sim.recordedSession()))
+                    << "Could not store the PPT session in " << captureFileName();
+        }
+    }
+
+    static std::string captureFileName() {
+        const char* dir = std::getenv("DSSC_SIM_CAPTURE_DIR");
+        const std::string captureDir = dir ? dir : configFilesDir() + "/captures";
+        return captureDir + "/" + testing::UnitTest::GetInstance()->current_test_info()->name() + ".capture";
+    }
+
+    static long envValue(const char* name, long defaultValue) {
+        const char* value = std::getenv(name);
+        return value ? std::atol(value) : defaultValue;
+    }
+
+    static std::string configFilesDir() {
+        const std::string filename = __FILE__;
+        std::size_t parent_dir_limit = filename.find_last_of("/", filename.find_last_of("/", filename.find_last_of("/")-1)-1);
+        return filename.substr(0, parent_dir_limit) + "/ConfigFiles";
+    }
+
+    static std::string fullConfigFileName() {
+        return configFilesDir() + "/F2Init.conf";
+    }
+
+    karabo::data::State waitWhileIn(const karabo::data::State& state, int timeoutSec = SLOT_TIMEOUT_SEC) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeoutSec);
+        karabo::data::State current = state;
+        while (current == state && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            current = m_deviceCli->get<karabo::data::State>(TEST_DEVICE_ID, "state");
+        }
+        return current;
+    }
+
+    // Instantiates the device, lets it autoconnect to the simulator and
+    // returns the time spent in open().
+    double connectDevice() {
+        const auto hash = karabo::data::Hash(
+            "deviceId", TEST_DEVICE_ID,
+            "quadrantId", "FENICE",
+            "pptHost", "127.0.0.1",
+            "pptPort", m_simPort,
+            "fullConfigFileName", fullConfigFileName());
+
+        std::pair<bool, std::string> success =
+            m_deviceCli->instantiate(DEVICE_SERVER_ID, "DsscPpt", hash, DEV_CLI_TIMEOUT_SEC);
+        EXPECT_TRUE(success.first) << "Error instantiating '" << TEST_DEVICE_ID << "':\n" << success.second;
+
+        waitWhileIn(karabo::data::State::INIT);
+        auto start = std::chrono::steady_clock::now();
+        waitWhileIn(karabo::data::State::OPENING);
+        return elapsedMs(start);
+    }
+
+    // Executes a slot on the device and returns the wall clock time it took.
+    double timeSlot(const std::string& slot) {
+        auto start = std::chrono::steady_clock::now();
+        m_deviceCli->execute(TEST_DEVICE_ID, slot, SLOT_TIMEOUT_SEC);
+        // Slots posting their work to the event loop report CHANGING or
+        // INIT while running.
+        waitWhileIn(karabo::data::State::CHANGING);
+        waitWhileIn(karabo::data::State::INIT);
+        return elapsedMs(start);
+    }
+
+    void report(const std::string& name, double ms) {
+        std::cout << "[ BENCH    ] " << name << ": " << ms << " ms ("
+                  << m_sim.numRequests() << " simulator requests, " << m_sim.numUnmatched() << " unmatched)" << std::endl;
+        RecordProperty(name + "_ms", std::to_string(ms));
+    }
+
+    static double elapsedMs(const std::chrono::steady_clock::time_point& start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    DSSC::PptLoopbackSimulator m_sim;
+    unsigned int m_simPort = 0;
+    bool m_recording = false;
+
+    std::thread m_eventLoopThread;
+
+    karabo::core::DeviceServer::Pointer m_deviceSrv;
+    karabo::core::DeviceClient::Pointer m_deviceCli;
+};
+
+
+TEST_F(DsscPptBenchFixture, benchOpen){
+    const double ms = connectDevice();
+    report("open", ms);
+    EXPECT_GE(m_sim.numConnections(), 1u) << "Device did not connect to the simulator";
+    EXPECT_EQ(m_deviceCli->get<karabo::data::State>(TEST_DEVICE_ID, "state"), karabo::data::State::OFF);
+    EXPECT_EQ(m_sim.numUnmatched(), 0u) << "Requests not in the recorded session, record it again";
+}
+
+
+TEST_F(DsscPptBenchFixture, benchProgrammingPaths){
+    report("open", connectDevice());
+
+    const auto state = m_deviceCli->get<karabo::data::State>(TEST_DEVICE_ID, "state");
+    ASSERT_EQ(state, karabo::data::State::OFF) << "Device did not reach OFF (state " << state.name()
+                                               << "), programming paths not measured";
+
+    for (const std::string slot : {"programJTAG", "programPixelRegister",
+                                   "updateSequencer", "initSystem"}) {
+        report(slot, timeSlot(slot));
+    }
+    EXPECT_EQ(m_sim.numUnmatched(), 0u) << "Requests not in the recorded session, record it again";
+}
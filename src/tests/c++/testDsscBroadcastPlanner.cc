@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../../DsscPpt/DsscBroadcastPlanner.hh"
+
+using karabo::BroadcastPlanner;
+
+TEST(DsscBroadcastPlannerTest, GroupsIdenticalContent) {
+    using Content = std::map<std::string, std::vector<uint32_t>>;
+    const Content a{{"Global FCSR 0", {1, 2, 3}}, {"Xor Ids", {7}}};
+    Content b = a;
+    b["Global FCSR 0"][1] = 5;
+
+    const auto same = BroadcastPlanner::groups(std::map<int, Content>{{1, a}, {2, a}, {3, a}, {4, a}});
+    ASSERT_EQ(same.size(), 1u);
+    EXPECT_EQ(same[0], (std::vector<int>{1, 2, 3, 4}));
+
+    const auto mixed = BroadcastPlanner::groups(std::map<int, Content>{{1, b}, {2, a}, {3, b}, {4, a}});
+    ASSERT_EQ(mixed.size(), 2u);
+    EXPECT_EQ(mixed[0], (std::vector<int>{1, 3})) << "First module of a group addressed";
+    EXPECT_EQ(mixed[1], (std::vector<int>{2, 4}));
+
+    EXPECT_TRUE(BroadcastPlanner::groups(std::map<int, Content>{}).empty());
+}
+
+TEST(DsscBroadcastPlannerTest, EngineMaskAndCounters) {
+    EXPECT_EQ(BroadcastPlanner::engineMask({1, 2, 3, 4}), 0xFu);
+    EXPECT_EQ(BroadcastPlanner::engineMask({2, 4}), 0xAu);
+    EXPECT_EQ(BroadcastPlanner::engineMask({0, 33}), 0u) << "Invalid modules";
+
+    BroadcastPlanner planner;
+    planner.addProgramming(4, 1);
+    planner.addProgramming(2, 2);
+    EXPECT_EQ(planner.modulesProgrammed(), 6u);
+    EXPECT_EQ(planner.passes(), 3u);
+}
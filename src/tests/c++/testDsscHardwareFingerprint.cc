@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include "../../DsscPpt/DsscHardwareFingerprint.hh"
+
+using karabo::HardwareFingerprint;
+
+TEST(DsscHardwareFingerprintTest, ComparesFields) {
+    HardwareFingerprint persisted;
+    persisted.set("serial", "0x1f0012");
+    persisted.set("pllLocked", "1");
+    persisted.set("activeIOBs", "15");
+
+    HardwareFingerprint current = persisted;
+    EXPECT_TRUE(current.differences(persisted).empty());
+
+    current.set("activeIOBs", "7");
+    current.set("firmware", "2023-01-01");
+    const auto diff = current.differences(persisted);
+    ASSERT_EQ(diff.size(), 2u);
+    EXPECT_EQ(diff[0], "activeIOBs");
+    EXPECT_EQ(diff[1], "firmware");
+
+    EXPECT_FALSE(HardwareFingerprint().differences(persisted).empty());
+}
+
+TEST(DsscHardwareFingerprintTest, SaveAndLoad) {
+    HardwareFingerprint fingerprint;
+    fingerprint.set("serial", "0x1f0012 PPTv3");
+    fingerprint.set("firmware", "build=42");
+
+    const std::string fileName = "testDsscHardwareFingerprint.fingerprint";
+    ASSERT_TRUE(fingerprint.save(fileName));
+    const auto loaded = HardwareFingerprint::load(fileName);
+    std::remove(fileName.c_str());
+
+    EXPECT_TRUE(loaded.differences(fingerprint).empty());
+    EXPECT_EQ(loaded.get("firmware"), "build=42");
+    EXPECT_TRUE(HardwareFingerprint::load(fileName).empty());
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include "../../DsscPpt/DsscHotReconfig.hh"
+
+using karabo::HotReconfigPolicy;
+using namespace std::chrono_literals;
+
+TEST(DsscHotReconfigTest, ClassifiesRegisters) {
+    HotReconfigPolicy policy;
+    EXPECT_EQ(policy.classify("IOB", "CLR_duty"), HotReconfigPolicy::SAFE);
+    EXPECT_EQ(policy.classify("IOB", "SYSFSM_burst_length"), HotReconfigPolicy::UNSAFE);
+    EXPECT_EQ(policy.classify("JTAG", "Global FCSR 0", "MonBusSwitch"), HotReconfigPolicy::SAFE);
+    EXPECT_EQ(policy.classify("JTAG", "Global FCSR 0", "TX_Disable"), HotReconfigPolicy::UNSAFE);
+    EXPECT_EQ(policy.classify("JTAG", "Global Control Register", "VDAC_highrange"), HotReconfigPolicy::SAFE);
+    EXPECT_EQ(policy.classify("JTAG", "Global FCSR 0"), HotReconfigPolicy::UNSAFE) << "Whole module set";
+    EXPECT_EQ(policy.classify("PIXEL", "Control register"), HotReconfigPolicy::UNSAFE) << "Unknown type";
+
+    EXPECT_EQ(policy.classifyAll({{"SEQ", "clr_cycle", ""}, {"IOB", "CLR_duty", ""}}), HotReconfigPolicy::SAFE);
+    EXPECT_EQ(policy.classifyAll({{"SEQ", "clr_cycle", ""}, {"SEQ", "burstLength", ""}}), HotReconfigPolicy::UNSAFE);
+    EXPECT_EQ(policy.classifyAll({}), HotReconfigPolicy::SAFE);
+
+    policy.setSafePatterns("SEQ", " burstLength , ");
+    EXPECT_EQ(policy.classify("SEQ", "burstLength"), HotReconfigPolicy::SAFE);
+    EXPECT_EQ(policy.classify("SEQ", "clr_cycle"), HotReconfigPolicy::UNSAFE);
+
+    policy.countHotWrite();
+    policy.countHotWrite();
+    policy.countUnsafeWrite();
+    policy.countOverrun();
+    EXPECT_EQ(policy.numHotWrites(), 2u);
+    EXPECT_EQ(policy.numUnsafeWrites(), 1u);
+    EXPECT_EQ(policy.numOverruns(), 1u);
+}
+
+TEST(DsscHotReconfigTest, NextTrainBoundary) {
+    const auto t0 = HotReconfigPolicy::Clock::now();
+    EXPECT_EQ(HotReconfigPolicy::nextTrainBoundary(t0, 100ms, t0 + 250ms), t0 + 300ms);
+    EXPECT_EQ(HotReconfigPolicy::nextTrainBoundary(t0, 100ms, t0), t0 + 100ms);
+    EXPECT_EQ(HotReconfigPolicy::nextTrainBoundary(t0 + 50ms, 100ms, t0), t0 + 50ms) << "Arrival in the future";
+    EXPECT_EQ(HotReconfigPolicy::nextTrainBoundary(t0, 0ms, t0 + 250ms), t0) << "No period known";
+}
+
+TEST(DsscHotReconfigTest, NextWriteStart) {
+    const auto t0 = HotReconfigPolicy::Clock::now();
+    // gaps from t0 + k * 100ms, each until 50ms later
+    EXPECT_EQ(HotReconfigPolicy::nextWriteStart(t0, 50ms, 100ms, 10ms, t0 + 20ms), t0 + 20ms);
+    EXPECT_EQ(HotReconfigPolicy::nextWriteStart(t0, 50ms, 100ms, 40ms, t0 + 20ms), t0 + 100ms) << "Overruns the gap";
+    EXPECT_EQ(HotReconfigPolicy::nextWriteStart(t0, 50ms, 100ms, 10ms, t0 + 260ms), t0 + 300ms) << "Train running";
+    EXPECT_EQ(HotReconfigPolicy::nextWriteStart(t0, 50ms, 100ms, 10ms, t0 + 210ms), t0 + 210ms) << "Later gap";
+    EXPECT_EQ(HotReconfigPolicy::nextWriteStart(t0 + 30ms, 50ms, 100ms, 10ms, t0), t0 + 30ms) << "Gap not started";
+}
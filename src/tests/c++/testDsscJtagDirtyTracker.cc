@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include "../../DsscPpt/DsscJtagDirtyTracker.hh"
+
+using karabo::JtagDirtyTracker;
+
+TEST(DsscJtagDirtyTrackerTest, TracksProgrammedValues) {
+    JtagDirtyTracker tracker;
+    const JtagDirtyTracker::Values values{1, 2, 3};
+    EXPECT_TRUE(tracker.isDirty(1, "Global Control Register", values)) << "Nothing programmed yet";
+
+    tracker.programmed(1, "Global Control Register", values);
+    tracker.programmed(1, "Global FCSR 0", {0});
+    tracker.programmed(2, "Global Control Register", values);
+    EXPECT_FALSE(tracker.isDirty(1, "Global Control Register", values));
+    EXPECT_TRUE(tracker.isDirty(1, "Global Control Register", {1, 2, 4})) << "One ASIC changed";
+    EXPECT_TRUE(tracker.isDirty(3, "Global Control Register", values)) << "Other module";
+
+    tracker.invalidate(1, "Global FCSR 0");
+    EXPECT_TRUE(tracker.isDirty(1, "Global FCSR 0", {0}));
+    EXPECT_FALSE(tracker.isDirty(1, "Global Control Register", values));
+
+    tracker.invalidate(1);
+    EXPECT_TRUE(tracker.isDirty(1, "Global Control Register", values));
+    EXPECT_FALSE(tracker.isDirty(2, "Global Control Register", values));
+
+    tracker.invalidateAll();
+    EXPECT_TRUE(tracker.isDirty(2, "Global Control Register", values));
+}
+
+TEST(DsscJtagDirtyTrackerTest, CountsBits) {
+    JtagDirtyTracker tracker;
+    tracker.addProgramming(1000, 1000);
+    tracker.addProgramming(1000, 16);
+    EXPECT_EQ(tracker.bitsRequested(), 2000u);
+    EXPECT_EQ(tracker.bitsShifted(), 1016u);
+}
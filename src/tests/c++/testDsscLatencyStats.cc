@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include "../../DsscPpt/DsscLatencyStats.hh"
+
+TEST(DsscLatencyStatsTest, HistogramPercentiles) {
+    karabo::LatencyHistogram hist;
+    EXPECT_EQ(hist.percentile(0.5), 0.0);
+
+    for (int i = 0; i < 95; ++i) hist.add(1.0);
+    for (int i = 0; i < 5; ++i) hist.add(100.0);
+
+    EXPECT_EQ(hist.count(), 100u);
+    EXPECT_DOUBLE_EQ(hist.max(), 100.0);
+    EXPECT_NEAR(hist.mean(), 5.95, 1e-9);
+    // log2 bins are accurate within a factor of two
+    EXPECT_GE(hist.percentile(0.5), 0.5);
+    EXPECT_LE(hist.percentile(0.5), 2.0);
+    EXPECT_LE(hist.percentile(0.95), 2.0);
+    EXPECT_GE(hist.percentile(0.99), 50.0);
+    EXPECT_LE(hist.percentile(1.0), 100.0);
+}
+
+TEST(DsscLatencyStatsTest, TableKeepsOriginsApart) {
+    karabo::LatencyStatsTable table;
+    table.add("programJTAG", 10.0);
+    table.add("programJTAG", 20.0);
+    table.add("pollHardware", 0.1);
+
+    const auto summary = table.summary();
+    ASSERT_EQ(summary.size(), 2u);
+    EXPECT_EQ(summary[0].name, "pollHardware");
+    EXPECT_EQ(summary[0].count, 1u);
+    EXPECT_EQ(summary[1].name, "programJTAG");
+    EXPECT_EQ(summary[1].count, 2u);
+    EXPECT_DOUBLE_EQ(summary[1].max, 20.0);
+
+    table.clear();
+    EXPECT_TRUE(table.summary().empty());
+}
+
+TEST(DsscLatencyStatsTest, RollingWindowForgetsOldSamples) {
+    karabo::RollingLatency rolling;
+    for (size_t i = 0; i < karabo::RollingLatency::WINDOW; ++i) rolling.add(100.0);
+    for (size_t i = 0; i < karabo::RollingLatency::WINDOW; ++i) rolling.add(static_cast<double>(i + 1));
+
+    EXPECT_EQ(rolling.count(), 2 * karabo::RollingLatency::WINDOW);
+    const auto p = rolling.percentiles({0.5, 0.95, 1.0});
+    EXPECT_DOUBLE_EQ(p[0], karabo::RollingLatency::WINDOW / 2);
+    EXPECT_DOUBLE_EQ(p[1], std::ceil(0.95 * karabo::RollingLatency::WINDOW));
+    EXPECT_DOUBLE_EQ(p[2], karabo::RollingLatency::WINDOW);
+}
+
+TEST(DsscLatencyStatsTest, ScopedTimerRecordsOperation) {
+    karabo::RollingStatsTable table;
+    {
+        karabo::ScopedLatencyTimer timer(table, "readFPGATemperature");
+    }
+    const auto summary = table.summary();
+    ASSERT_EQ(summary.size(), 1u);
+    EXPECT_EQ(summary[0].name, "readFPGATemperature");
+    EXPECT_EQ(summary[0].count, 1u);
+    EXPECT_GE(summary[0].max, 0.0);
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include "../../DsscPpt/DsscLinkHealth.hh"
+
+using karabo::LinkHealth;
+using namespace std::chrono_literals;
+
+TEST(DsscLinkHealthTest, CountsFailuresPerAsic) {
+    LinkHealth health;
+    const auto t0 = LinkHealth::Clock::now();
+    EXPECT_EQ(health.summary(t0), "all links ok");
+
+    // ASIC 3 of IOB 2 fails in every fourth sample, ASIC 0 once
+    for (int i = 0; i < 40; ++i) {
+        uint16_t failures = (i % 4 == 0) ? (1 << 3) : 0;
+        if (i == 39) failures |= 1;
+        health.addSample(t0 + i * 1s, 2, failures);
+        health.addSample(t0 + i * 1s, 1, 0);
+    }
+    const auto now = t0 + 39s;
+    EXPECT_EQ(health.numSamples(2), 40u);
+    EXPECT_EQ(health.failureCounts(2)[3], 10u);
+    EXPECT_EQ(health.failureCounts(2)[0], 1u);
+    EXPECT_DOUBLE_EQ(health.failureRates(2, 60s, now)[3], 0.25);
+    EXPECT_DOUBLE_EQ(health.failureRates(1, 60s, now)[3], 0.0);
+    EXPECT_EQ(health.summary(now), "IOB2: ASIC 0 2.5%, ASIC 3 25.0%");
+
+    health.setAuroraReady(4, false);
+    EXPECT_EQ(health.summary(now), "IOB2: ASIC 0 2.5%, ASIC 3 25.0%; IOB4: aurora not ready");
+
+    health.reset();
+    EXPECT_EQ(health.numSamples(2), 0u);
+    EXPECT_EQ(health.summary(now), "all links ok");
+}
+
+TEST(DsscLinkHealthTest, RatesUseSlidingWindows) {
+    LinkHealth health;
+    const auto t0 = LinkHealth::Clock::now();
+
+    // failures in the first 10 minutes, none in the next 10 minutes
+    for (int i = 0; i < 120; ++i) {
+        health.addSample(t0 + i * 10s, 1, (i < 60) ? 0x8000 : 0);
+    }
+    const auto now = t0 + 1190s;
+    EXPECT_DOUBLE_EQ(health.failureRates(1, 60s, now)[15], 0.0);
+    EXPECT_DOUBLE_EQ(health.failureRates(1, 3600s, now)[15], 0.5);
+    EXPECT_EQ(health.failureCounts(1)[15], 60u);
+
+    // samples older than the longest window are dropped, the counts are kept
+    health.addSample(t0 + 7200s, 1, 0);
+    EXPECT_DOUBLE_EQ(health.failureRates(1, 3600s, t0 + 7200s)[15], 0.0);
+    EXPECT_EQ(health.failureCounts(1)[15], 60u);
+
+    // invalid IOB numbers are ignored
+    health.addSample(now, 5, 0xFFFF);
+    EXPECT_TRUE(health.failureCounts(5).empty());
+}
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include "../../DsscPpt/DsscOperationProgress.hh"
+
+using karabo::OperationProgress;
+
+TEST(DsscOperationProgressTest, ReportsStepsAndFinishes) {
+    OperationProgress progress;
+    int notifications = 0;
+    progress.setListener([&notifications] { notifications++; });
+
+    {
+        karabo::ScopedOperation op(progress, "initSystem", 4);
+        EXPECT_TRUE(op.nextStep("resetAll"));
+        EXPECT_TRUE(op.nextStep("programPLL"));
+        EXPECT_TRUE(op.nextStep("programIOBFPGAs"));
+
+        const auto snap = progress.snapshot();
+        EXPECT_EQ(snap.name, "initSystem");
+        EXPECT_EQ(snap.step, "programIOBFPGAs");
+        EXPECT_DOUBLE_EQ(snap.percent, 50.0);
+        EXPECT_GE(snap.eta, 0.0);
+        EXPECT_EQ(snap.result, OperationProgress::Result::RUNNING);
+    }
+    const auto snap = progress.snapshot();
+    EXPECT_DOUBLE_EQ(snap.percent, 100.0);
+    EXPECT_EQ(snap.result, OperationProgress::Result::FINISHED);
+    EXPECT_EQ(notifications, 5);
+}
+
+TEST(DsscOperationProgressTest, AbortStopsAtNextStep) {
+    OperationProgress progress;
+    EXPECT_FALSE(progress.abort()) << "Nothing to abort when idle";
+
+    karabo::ScopedOperation outer(progress, "initSystem", 2);
+    EXPECT_TRUE(outer.nextStep("programIOBFPGAs"));
+    {
+        // nested operations keep the outer name and step count
+        karabo::ScopedOperation inner(progress, "programAllIOBFPGAs", 5);
+        EXPECT_TRUE(inner.nextStep("programIOB1"));
+        EXPECT_EQ(progress.snapshot().name, "initSystem");
+        EXPECT_TRUE(progress.abort());
+        EXPECT_FALSE(inner.nextStep("programIOB2"));
+    }
+    EXPECT_FALSE(outer.nextStep("initChip"));
+    EXPECT_EQ(progress.snapshot().result, OperationProgress::Result::ABORTED);
+}
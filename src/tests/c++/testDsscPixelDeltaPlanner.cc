@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "../../DsscPpt/DsscPixelDeltaPlanner.hh"
+
+using karabo::PixelDeltaPlanner;
+using karabo::PixelStrategy;
+
+TEST(DsscPixelDeltaPlannerTest, Fingerprints) {
+    const auto pixels = PixelDeltaPlanner::fingerprints({{1, 1, 2, 1}, {5, 5, 5, 6}});
+    ASSERT_EQ(pixels.size(), 4u);
+    EXPECT_EQ(pixels[0], pixels[1]);
+    EXPECT_NE(pixels[0], pixels[2]);
+    EXPECT_NE(pixels[0], pixels[3]);
+    EXPECT_NE(pixels[2], pixels[3]);
+    EXPECT_TRUE(PixelDeltaPlanner::fingerprints({}).empty());
+}
+
+TEST(DsscPixelDeltaPlannerTest, PicksCheapestStrategy) {
+    PixelDeltaPlanner planner;
+    planner.setBitsPerPixel(50);
+    planner.setDirectOverheadBits(50);
+
+    std::vector<std::vector<uint32_t>> values{std::vector<uint32_t>(1000, 7)};
+    auto plan = planner.plan(1, values);
+    EXPECT_EQ(plan.strategy, PixelStrategy::UNIFORM) << "Unknown module with equal pixels";
+    EXPECT_EQ(plan.bits, 50u);
+
+    values[0][3] = 8;
+    const auto programmed = values;
+    plan = planner.plan(1, values);
+    EXPECT_EQ(plan.strategy, PixelStrategy::FULL) << "Unknown module";
+    EXPECT_EQ(plan.bits, 50000u);
+    EXPECT_EQ(plan.pixels.size(), 1000u);
+    planner.programmed(1, values);
+
+    EXPECT_EQ(planner.plan(1, values).strategy, PixelStrategy::NONE);
+
+    // a handful of outliers
+    values[0][10] = 1;
+    values[0][500] = 1;
+    plan = planner.plan(1, values);
+    EXPECT_EQ(plan.strategy, PixelStrategy::DIRECT);
+    EXPECT_EQ(plan.pixels, (std::vector<uint32_t>{10, 500}));
+    EXPECT_EQ(plan.bits, 200u);
+
+    // more than half of the pixels is cheaper in one stream
+    for (size_t px = 0; px < 600; ++px) values[0][px] = 2;
+    plan = planner.plan(1, values);
+    EXPECT_EQ(plan.strategy, PixelStrategy::FULL);
+    EXPECT_EQ(plan.pixels.size(), 600u);
+
+    EXPECT_EQ(planner.plan(2, programmed).strategy, PixelStrategy::FULL) << "Other module";
+    planner.invalidateAll();
+    EXPECT_EQ(planner.plan(1, programmed).strategy, PixelStrategy::FULL);
+}
+
+TEST(DsscPixelDeltaPlannerTest, ComparesContent) {
+    PixelDeltaPlanner planner;
+    planner.setBitsPerPixel(50);
+    planner.setDirectOverheadBits(50);
+
+    std::vector<std::vector<uint32_t>> values{std::vector<uint32_t>(100, 1), std::vector<uint32_t>(100, 2)};
+    planner.programmed(1, values);
+    EXPECT_EQ(planner.plan(1, values).strategy, PixelStrategy::NONE);
+
+    // values swapped between signals of one pixel
+    values[0][7] = 2;
+    values[1][7] = 1;
+    auto plan = planner.plan(1, values);
+    EXPECT_EQ(plan.strategy, PixelStrategy::DIRECT);
+    EXPECT_EQ(plan.pixels, (std::vector<uint32_t>{7}));
+
+    values.push_back(std::vector<uint32_t>(100, 0));
+    EXPECT_EQ(planner.plan(1, values).strategy, PixelStrategy::FULL) << "Other signals";
+    values.pop_back();
+    values[1].pop_back();
+    plan = planner.plan(1, values);
+    EXPECT_EQ(plan.strategy, PixelStrategy::FULL) << "Inconsistent signal lengths";
+    EXPECT_EQ(plan.pixels.size(), 100u);
+}
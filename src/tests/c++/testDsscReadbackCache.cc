@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "../../DsscPpt/DsscReadbackCache.hh"
+
+using karabo::ReadbackCache;
+using namespace std::chrono_literals;
+
+TEST(DsscReadbackCacheTest, HitsWithinTimeToLive) {
+    ReadbackCache cache;
+    EXPECT_FALSE(cache.lookup("EPC/Single_Cycle_Register")) << "Disabled cache must always miss";
+    cache.update("EPC/Single_Cycle_Register");
+    EXPECT_FALSE(cache.lookup("EPC/Single_Cycle_Register"));
+
+    cache.setTimeToLive(50ms);
+    EXPECT_TRUE(cache.lookup("EPC/Single_Cycle_Register"));
+    EXPECT_FALSE(cache.lookup("EPC/AuroraRX_Control"));
+    std::this_thread::sleep_for(60ms);
+    EXPECT_FALSE(cache.lookup("EPC/Single_Cycle_Register"));
+
+    EXPECT_EQ(cache.hits(), 1u);
+    EXPECT_EQ(cache.misses(), 4u);
+}
+
+TEST(DsscReadbackCacheTest, GroupsAndInvalidation) {
+    ReadbackCache cache;
+    cache.setTimeToLive(10s);
+
+    cache.update("EPC");
+    EXPECT_TRUE(cache.lookup("EPC/Single_Cycle_Register"));
+    EXPECT_FALSE(cache.lookup("IOB1"));
+
+    // programming one module set invalidates the full readback as well
+    cache.invalidate("EPC/Single_Cycle_Register");
+    EXPECT_FALSE(cache.lookup("EPC/Single_Cycle_Register"));
+    EXPECT_FALSE(cache.lookup("EPC/AuroraRX_Control"));
+
+    cache.update("EPC/AuroraRX_Control");
+    cache.update("IOB1");
+    cache.invalidate("EPC");
+    EXPECT_FALSE(cache.lookup("EPC/AuroraRX_Control"));
+    EXPECT_TRUE(cache.lookup("IOB1"));
+
+    cache.invalidateAll();
+    EXPECT_FALSE(cache.lookup("IOB1"));
+}
+
+TEST(DsscReadbackCacheTest, StatusRegistersAlwaysMiss) {
+    ReadbackCache cache;
+    cache.setTimeToLive(10s);
+
+    cache.update("EPC");
+    cache.update("EPC/PLLReadbackRegister");
+    EXPECT_FALSE(cache.lookup("EPC/PLLReadbackRegister")) << "PLL lock changes without a write";
+    EXPECT_FALSE(cache.lookup("EPC/CLOCK_FANOUT_CONTROL")) << "Holds the MMCM lock";
+    EXPECT_FALSE(cache.lookup("EPC/XADC_Temp_out"));
+    EXPECT_TRUE(cache.lookup("EPC/Single_Cycle_Register"));
+
+    EXPECT_TRUE(ReadbackCache::isStatusRegister("Data_Receive_Status_0"));
+    EXPECT_FALSE(ReadbackCache::isStatusRegister("JTAG_Control_Register"));
+}
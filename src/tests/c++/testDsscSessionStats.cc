@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "../../DsscPpt/DsscSessionStats.hh"
+
+using karabo::SessionStats;
+using namespace std::chrono_literals;
+
+TEST(DsscSessionStatsTest, CountsTrainsAndGaps) {
+    SessionStats stats;
+    const auto t0 = SessionStats::Clock::now();
+    stats.start(t0, 1000.0, 50.0);
+    EXPECT_TRUE(stats.isRunning());
+
+    // sampled every 0.5 s, 5 trains per sample
+    uint64_t trainId = 100;
+    for (int i = 0; i <= 10; ++i) {
+        stats.addTrainId(t0 + i * 500ms, trainId);
+        stats.addOutputRate(i == 3 ? 1000 : 3000);
+        trainId += 5;
+    }
+    // the train id freezes for 20 trains until the last sample, then jumps to the current train
+    for (int i = 11; i <= 14; ++i) {
+        stats.addTrainId(t0 + i * 500ms, 150);
+    }
+    stats.addTrainId(t0 + 7500ms, 175);
+    // a jump of 20 trains within 0.5 s
+    stats.addTrainId(t0 + 8000ms, 200);
+    stats.addTrainId(t0 + 8500ms, 205);
+    stats.addRecoveryTime(1500ms);
+
+    const auto session = stats.stop(t0 + 10s, 1010.0, 80.0);
+    EXPECT_FALSE(stats.isRunning());
+    EXPECT_EQ(session.firstTrainId, 100u);
+    EXPECT_EQ(session.lastTrainId, 205u);
+    EXPECT_EQ(session.numGaps, 2u);
+    EXPECT_EQ(session.trainsExpected, 100u);
+    EXPECT_EQ(session.trainsSeen, 100u - 20u - 20u);
+    EXPECT_NEAR(session.meanOutputRate, (10 * 3000.0 + 1000.0) / 11, 1e-9);
+    EXPECT_DOUBLE_EQ(session.minOutputRate, 1000.0);
+    EXPECT_DOUBLE_EQ(session.recoveryTime, 1.5);
+    EXPECT_DOUBLE_EQ(session.lockWaitTime, 30.0);
+    EXPECT_DOUBLE_EQ(session.stopTime, 1010.0);
+
+    stats.addTrainId(t0 + 11s, 300);
+    EXPECT_EQ(stats.last(5).size(), 1u) << "No samples outside a session";
+    EXPECT_EQ(stats.stop(t0 + 12s, 0, 0).trainsExpected, 0u);
+}
+
+TEST(DsscSessionStatsTest, KeepsLastSessions) {
+    SessionStats stats;
+    const auto t0 = SessionStats::Clock::now();
+    for (size_t i = 0; i < SessionStats::MAX_SESSIONS + 5; ++i) {
+        stats.start(t0, i, 0);
+        stats.stop(t0 + 1s, i + 1, 0);
+    }
+    const auto sessions = stats.last(3);
+    ASSERT_EQ(sessions.size(), 3u);
+    EXPECT_DOUBLE_EQ(sessions.back().startTime, SessionStats::MAX_SESSIONS + 4);
+    EXPECT_DOUBLE_EQ(sessions.front().startTime, SessionStats::MAX_SESSIONS + 2);
+    EXPECT_EQ(stats.last(1000).size(), SessionStats::MAX_SESSIONS);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "../../DsscPpt/DsscStallWatchdog.hh"
+
+using karabo::StallAction;
+using karabo::StallWatchdog;
+using namespace std::chrono_literals;
+
+TEST(DsscStallWatchdogTest, EscalatesRecovery) {
+    StallWatchdog watchdog;
+    watchdog.setStallTime(1000ms);
+    const auto t0 = StallWatchdog::Clock::now();
+
+    // IOB 2 reports failing channels while data is sent
+    uint64_t trainId = 100;
+    auto sample = [&](std::chrono::milliseconds t, uint16_t failures2) {
+        trainId++;
+        return watchdog.update(t0 + t, trainId, 500, {{1, 0}, {2, failures2}});
+    };
+    EXPECT_EQ(sample(0ms, 0).action, StallAction::NONE);
+    EXPECT_EQ(sample(500ms, 0x10).action, StallAction::NONE);
+    EXPECT_EQ(sample(1000ms, 0x10).action, StallAction::NONE);
+
+    auto recovery = sample(1500ms, 0x10);
+    EXPECT_EQ(recovery.action, StallAction::AURORA_RESET);
+    EXPECT_EQ(recovery.iobs, std::vector<int>({2}));
+    EXPECT_EQ(watchdog.numStalls(), 1u);
+    EXPECT_EQ(sample(1600ms, 0x10).action, StallAction::NONE) << "Waits while the recovery runs";
+
+    // the aurora reset does not help, the module is re-initialised
+    watchdog.recoveryFinished(t0 + 1700ms);
+    EXPECT_EQ(sample(2200ms, 0x10).action, StallAction::NONE);
+    recovery = sample(2700ms, 0x10);
+    EXPECT_EQ(recovery.action, StallAction::REINIT_MODULE);
+    EXPECT_EQ(watchdog.numFailedRecoveries(), 1u);
+
+    watchdog.recoveryFinished(t0 + 4000ms);
+    EXPECT_EQ(sample(4500ms, 0).action, StallAction::NONE);
+    EXPECT_EQ(watchdog.numRecovered(), 0u) << "Success is only known after the stall time";
+    EXPECT_EQ(sample(5000ms, 0).action, StallAction::NONE);
+    EXPECT_EQ(watchdog.numRecovered(), 1u);
+    EXPECT_EQ(watchdog.lastRecoveryTime(), 2500u) << "From detection to the end of the re-init";
+    EXPECT_EQ(watchdog.numRecoveries(), 2u);
+    EXPECT_EQ(watchdog.status(), "WATCHING");
+}
+
+TEST(DsscStallWatchdogTest, DetectsMissingData) {
+    StallWatchdog watchdog;
+    watchdog.setStallTime(1000ms);
+    const auto t0 = StallWatchdog::Clock::now();
+
+    EXPECT_EQ(watchdog.update(t0, 1, 500, {{1, 0}, {3, 0}}).action, StallAction::NONE);
+    EXPECT_EQ(watchdog.update(t0 + 500ms, 6, 0, {{1, 0}, {3, 0}}).action, StallAction::NONE);
+    const auto recovery = watchdog.update(t0 + 1000ms, 11, 0, {{1, 0}, {3, 0}});
+    EXPECT_EQ(recovery.action, StallAction::AURORA_RESET);
+    EXPECT_EQ(recovery.iobs, std::vector<int>({1, 3})) << "Without failures all IOBs are reset";
+}
+
+TEST(DsscStallWatchdogTest, GivesUpOnStalledTrainId) {
+    StallWatchdog watchdog;
+    watchdog.setStallTime(1000ms);
+    const auto t0 = StallWatchdog::Clock::now();
+
+    watchdog.update(t0, 1, 500, {});
+    EXPECT_EQ(watchdog.update(t0 + 1000ms, 1, 500, {}).action, StallAction::GIVE_UP);
+    EXPECT_EQ(watchdog.status(), "GAVE_UP");
+    EXPECT_EQ(watchdog.update(t0 + 1500ms, 1, 500, {}).action, StallAction::NONE);
+    watchdog.update(t0 + 1600ms, 2, 500, {});
+    EXPECT_EQ(watchdog.status(), "WATCHING");
+    EXPECT_EQ(watchdog.numRecoveries(), 0u);
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include "../../DsscPpt/DsscTelemetryHistory.hh"
+
+using karabo::TelemetryHistory;
+using karabo::TelemetrySample;
+
+namespace {
+
+    TelemetrySample makeSample(uint64_t trainId) {
+        return TelemetrySample{trainId * 0.1, trainId, static_cast<int32_t> (trainId % 100),
+                               static_cast<uint32_t> (trainId * 2), {1, 2, 3, static_cast<int32_t> (trainId)}};
+    }
+}
+
+TEST(DsscTelemetryHistoryTest, KeepsLastSamples) {
+    TelemetryHistory history;
+    EXPECT_TRUE(history.last(10).empty());
+
+    for (uint64_t train = 1; train <= 5; ++train) {
+        history.push(makeSample(train));
+    }
+    auto samples = history.last(3);
+    ASSERT_EQ(samples.size(), 3u);
+    EXPECT_EQ(samples.front().trainId, 3u);
+    EXPECT_EQ(samples.back().trainId, 5u);
+    EXPECT_EQ(samples.back().ethOutputRate, 10u);
+    EXPECT_EQ(samples.back().iobTemp[3], 5);
+    EXPECT_EQ(history.last(100).size(), 5u);
+
+    for (uint64_t train = 6; train <= TelemetryHistory::CAPACITY + 10; ++train) {
+        history.push(makeSample(train));
+    }
+    samples = history.last(TelemetryHistory::CAPACITY + 100);
+    ASSERT_EQ(samples.size(), TelemetryHistory::CAPACITY);
+    EXPECT_EQ(samples.front().trainId, 11u);
+    EXPECT_EQ(history.numWritten(), TelemetryHistory::CAPACITY + 10);
+}
+
+TEST(DsscTelemetryHistoryTest, ReadersSeeConsistentSamples) {
+    TelemetryHistory history;
+    std::atomic<bool> done(false);
+
+    std::thread writer([&] {
+        for (uint64_t train = 1; train <= 200000; ++train) {
+            history.push(makeSample(train));
+        }
+        done = true;
+    });
+
+    size_t checked = 0;
+    bool writing = true;
+    while (writing) {
+        writing = !done;
+        for (const auto & sample : history.last(64)) {
+            EXPECT_EQ(sample.ethOutputRate, sample.trainId * 2);
+            EXPECT_EQ(sample.iobTemp[3], static_cast<int32_t> (sample.trainId));
+            checked++;
+        }
+    }
+    writer.join();
+    EXPECT_GE(checked, 64u);
+}
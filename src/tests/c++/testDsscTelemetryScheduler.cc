@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include "../../DsscPpt/DsscTelemetryScheduler.hh"
+
+using karabo::TelemetryMode;
+using karabo::TelemetryScheduler;
+using namespace std::chrono_literals;
+
+TEST(DsscTelemetrySchedulerTest, IntervalsDependOnMode) {
+    TelemetryScheduler scheduler;
+    scheduler.addMetric("pptTemp", [](TelemetryMode) { return 5000ms; });
+    scheduler.addMetric("ethOutputRate", [](TelemetryMode mode) {
+        return mode == TelemetryMode::ACQUIRING ? 1000ms : mode == TelemetryMode::ON ? 5000ms : 0ms;
+    });
+
+    const auto t0 = TelemetryScheduler::Clock::now();
+    EXPECT_EQ(scheduler.dueMetrics(t0, TelemetryMode::IDLE), std::vector<std::string>({"pptTemp"}));
+    auto due = scheduler.dueMetrics(t0, TelemetryMode::ACQUIRING);
+    EXPECT_EQ(due.size(), 2u) << "Metrics never read are due at once and batched";
+    scheduler.markDone(due, t0);
+
+    EXPECT_TRUE(scheduler.dueMetrics(t0 + 500ms, TelemetryMode::ACQUIRING).empty());
+    EXPECT_EQ(scheduler.nextDue(t0, TelemetryMode::ACQUIRING), t0 + 900ms);
+    EXPECT_EQ(scheduler.dueMetrics(t0 + 950ms, TelemetryMode::ACQUIRING), std::vector<std::string>({"ethOutputRate"}));
+    EXPECT_EQ(scheduler.nextDue(t0, TelemetryMode::IDLE), t0 + TelemetryScheduler::MAX_SLEEP);
+
+    // close deadlines share a batch
+    EXPECT_EQ(scheduler.dueMetrics(t0 + 4600ms, TelemetryMode::ON).size(), 2u);
+}
+
+TEST(DsscTelemetrySchedulerTest, DeadlineOverridesInterval) {
+    TelemetryScheduler scheduler;
+    scheduler.addMetric("trainId", [](TelemetryMode) { return 30ms; });
+
+    const auto t0 = TelemetryScheduler::Clock::now();
+    scheduler.markDone({"trainId"}, t0);
+    scheduler.scheduleAt("trainId", t0 + 2000ms);
+    EXPECT_TRUE(scheduler.dueMetrics(t0 + 500ms, TelemetryMode::ACQUIRING).empty());
+    EXPECT_EQ(scheduler.nextDue(t0 + 1500ms, TelemetryMode::ACQUIRING), t0 + 2000ms);
+    EXPECT_EQ(scheduler.dueMetrics(t0 + 2000ms, TelemetryMode::ACQUIRING).size(), 1u);
+
+    // a deadline set while reading stays for the next read
+    scheduler.scheduleAt("trainId", t0 + 3000ms);
+    scheduler.markDone({"trainId"}, t0 + 2000ms);
+    EXPECT_TRUE(scheduler.dueMetrics(t0 + 2100ms, TelemetryMode::ACQUIRING).empty());
+
+    // after the scheduled read the interval applies again
+    scheduler.markDone({"trainId"}, t0 + 3000ms);
+    EXPECT_EQ(scheduler.nextDue(t0 + 3000ms, TelemetryMode::ACQUIRING), t0 + 3027ms);
+}
+
+TEST(DsscTelemetrySchedulerTest, RunsBatchesUntilStopped) {
+    TelemetryScheduler scheduler;
+    scheduler.addMetric("trainId", [](TelemetryMode mode) {
+        return mode == TelemetryMode::ACQUIRING ? 20ms : 0ms;
+    });
+
+    std::atomic<TelemetryMode> mode(TelemetryMode::IDLE);
+    std::atomic<int> reads(0);
+    scheduler.start([&mode] { return mode.load(); }, [&reads](const std::vector<std::string> & due) {
+        reads += due.size();
+        return true;
+    });
+
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(reads, 0);
+
+    mode = TelemetryMode::ACQUIRING;
+    scheduler.wakeUp();
+    std::this_thread::sleep_for(200ms);
+    scheduler.stop();
+
+    EXPECT_GE(reads, 5);
+    EXPECT_LE(reads, 15);
+    EXPECT_EQ(scheduler.numReads(), static_cast<uint64_t> (reads));
+    EXPECT_FALSE(scheduler.isRunning());
+}
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include "../../DsscPpt/DsscThrottleTuner.hh"
+
+using karabo::ThrottleTuner;
+
+TEST(DsscThrottleTunerTest, FindsFastestDividerWithoutLoss) {
+    // frames are lost below a divider of 37
+    for (uint32_t start : {100u, 37u, 64u, 1023u}) {
+        ThrottleTuner tuner(start);
+        while (!tuner.done()) {
+            tuner.report(tuner.next() < 37);
+        }
+        EXPECT_EQ(tuner.result(), 37u) << "Search from " << start;
+        EXPECT_LE(tuner.numTests(), ThrottleTuner::maxTests(start));
+    }
+
+    ThrottleTuner lossFree(50);
+    while (!lossFree.done()) lossFree.report(false);
+    EXPECT_EQ(lossFree.result(), 0u);
+
+    EXPECT_TRUE(ThrottleTuner(0).done());
+    EXPECT_EQ(ThrottleTuner::maxTests(0), 0u);
+    EXPECT_EQ(ThrottleTuner::maxTests(1023), 10u);
+}
+
+TEST(DsscThrottleTunerTest, StoresDividersPerConfiguration) {
+    const std::string fileName = "testDsscThrottleTuner.throttle";
+    std::map<std::string, uint32_t> dividers{{"00:1b:21:55:1f:c8/192.168.142.165:4321|800", 37}, {"other", 5}};
+    ASSERT_TRUE(ThrottleTuner::save(fileName, dividers));
+    const auto loaded = ThrottleTuner::load(fileName);
+    std::remove(fileName.c_str());
+
+    EXPECT_EQ(loaded, dividers);
+    EXPECT_TRUE(ThrottleTuner::load(fileName).empty());
+}
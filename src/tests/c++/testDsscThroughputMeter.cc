@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "../../DsscPpt/DsscThroughputMeter.hh"
+
+using karabo::ThroughputMeter;
+using namespace std::chrono_literals;
+
+TEST(DsscThroughputMeterTest, ExpectedRate) {
+    // 800 frames of 16 ASICs, 4096 pixels of 2 bytes, 10 trains per second
+    EXPECT_DOUBLE_EQ(ThroughputMeter::expectedChannelRate(800, 16), 8388.608);
+    EXPECT_DOUBLE_EQ(ThroughputMeter::expectedChannelRate(800, 0), 0.0);
+}
+
+TEST(DsscThroughputMeterTest, AttributesDeficitToCongestedChannels) {
+    ThroughputMeter meter;
+    meter.setWindow(10s);
+    const auto t0 = ThroughputMeter::Clock::now();
+    const std::array<double, 4> expected{1000, 1000, 1000, 0};
+
+    // all channels at full rate
+    for (int i = 0; i < 5; ++i) {
+        meter.addSample(t0 + i * 1s, 3000, {false, false, false, false});
+    }
+    auto channels = meter.throughput(t0 + 4s, expected);
+    EXPECT_DOUBLE_EQ(channels[0].rate, 1000);
+    EXPECT_DOUBLE_EQ(channels[1].deficit, 0);
+    EXPECT_FALSE(channels[2].belowExpected);
+    EXPECT_DOUBLE_EQ(channels[3].rate, 0) << "Inactive channel";
+
+    // channel 2 is congested in every sample, 600 MBit/s are missing
+    for (int i = 5; i < 20; ++i) {
+        meter.addSample(t0 + i * 1s, 2400, {false, true, false, false});
+    }
+    channels = meter.throughput(t0 + 19s, expected);
+    EXPECT_DOUBLE_EQ(channels[1].congestion, 1.0);
+    EXPECT_DOUBLE_EQ(channels[1].rate, 400);
+    EXPECT_DOUBLE_EQ(channels[1].deficit, 60);
+    EXPECT_TRUE(channels[1].belowExpected);
+    EXPECT_DOUBLE_EQ(channels[0].rate, 1000);
+    EXPECT_FALSE(channels[0].belowExpected);
+}
+
+TEST(DsscThroughputMeterTest, ReportsOnlyTotalDeficitWithoutCongestion) {
+    ThroughputMeter meter;
+    meter.setThreshold(5);
+    const auto t0 = ThroughputMeter::Clock::now();
+    meter.addSample(t0, 1800, {false, false, false, false});
+
+    // nothing points to a channel, none is blamed
+    const auto channels = meter.throughput(t0, {1000, 1000, 0, 0});
+    EXPECT_DOUBLE_EQ(channels[0].rate, 1000);
+    EXPECT_DOUBLE_EQ(channels[1].deficit, 0);
+    EXPECT_FALSE(channels[0].belowExpected);
+    EXPECT_FALSE(channels[1].belowExpected);
+
+    const auto total = meter.total(t0, {1000, 1000, 0, 0});
+    EXPECT_DOUBLE_EQ(total.rate, 1800);
+    EXPECT_DOUBLE_EQ(total.expectedRate, 2000);
+    EXPECT_DOUBLE_EQ(total.deficit, 10);
+    EXPECT_DOUBLE_EQ(total.congestion, 0);
+    EXPECT_TRUE(total.belowExpected);
+
+    EXPECT_DOUBLE_EQ(meter.throughput(t0 + 20s, {1000, 1000, 0, 0})[0].rate, 0) << "No samples in the window";
+    EXPECT_DOUBLE_EQ(meter.total(t0 + 20s, {1000, 1000, 0, 0}).deficit, 0) << "No samples in the window";
+}
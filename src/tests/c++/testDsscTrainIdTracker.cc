@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "../../DsscPpt/DsscTrainIdTracker.hh"
+
+using karabo::TrainIdTracker;
+using namespace std::chrono_literals;
+
+namespace {
+
+    // Train id of a 10 Hz clock which started train 1000 at t0 + 37ms
+    uint64_t trainAt(TrainIdTracker::Clock::time_point t0, TrainIdTracker::Clock::time_point t) {
+        return 1000 + (t - t0 - 37ms) / 100ms;
+    }
+}
+
+TEST(DsscTrainIdTrackerTest, PredictsArrivalFromEdges) {
+    TrainIdTracker tracker;
+    const auto t0 = TrainIdTracker::Clock::now();
+    EXPECT_FALSE(tracker.isReady());
+
+    // poll every 30 ms for a quarter of a second
+    for (auto t = t0 + 40ms; t < t0 + 300ms; t += 30ms) {
+        tracker.addSample(t, trainAt(t0, t));
+    }
+    ASSERT_TRUE(tracker.isReady());
+    EXPECT_DOUBLE_EQ(tracker.period(), 0.1);
+
+    // train 1100 starts at t0 + 10037ms, edges are known within 15 ms
+    const auto arrival = tracker.predictArrival(1100);
+    EXPECT_LT(arrival, t0 + 10037ms + 15ms);
+    EXPECT_GT(arrival, t0 + 10037ms - 15ms);
+    EXPECT_EQ(tracker.predictTrainId(t0 + 10087ms), 1100u);
+    EXPECT_EQ(tracker.predictTrainId(t0 + 9987ms), 1099u);
+}
+
+TEST(DsscTrainIdTrackerTest, FitsPeriodOverLongSpans) {
+    // a clock running 1% slow
+    TrainIdTracker tracker;
+    const auto t0 = TrainIdTracker::Clock::now();
+    for (int edge = 0; edge < 20; ++edge) {
+        const auto t = t0 + edge * 101ms;
+        tracker.addSample(t - 5ms, 2000 + edge - 1);
+        tracker.addSample(t + 5ms, 2000 + edge);
+    }
+    EXPECT_NEAR(tracker.period(), 0.101, 1e-6);
+    EXPECT_EQ(tracker.predictTrainId(t0 + 1000 * 101ms + 50ms), 3000u);
+}
+
+TEST(DsscTrainIdTrackerTest, ResetsOnClockJumps) {
+    TrainIdTracker tracker;
+    const auto t0 = TrainIdTracker::Clock::now();
+    for (auto t = t0 + 40ms; t < t0 + 300ms; t += 30ms) {
+        tracker.addSample(t, trainAt(t0, t));
+    }
+    ASSERT_TRUE(tracker.isReady());
+
+    // a read one train off is close to an edge and kept
+    tracker.addSample(t0 + 1000ms, trainAt(t0, t0 + 1000ms) + 1);
+    EXPECT_TRUE(tracker.isReady());
+
+    tracker.addSample(t0 + 1100ms, 50);
+    EXPECT_FALSE(tracker.isReady());
+    tracker.addSample(t0 + 1200ms, 51);
+    tracker.addSample(t0 + 1300ms, 52);
+    ASSERT_TRUE(tracker.isReady());
+    EXPECT_EQ(tracker.predictTrainId(t0 + 1800ms), 57u);
+}
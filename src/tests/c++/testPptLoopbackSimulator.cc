@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#include "PptLoopbackSimulator.hh"
+
+using namespace std::chrono;
+using Segment = DSSC::PptLoopbackSimulator::Segment;
+
+namespace {
+
+    DSSC::PptLoopbackSimulator::Session recordedPolling() {
+        return {{Segment{false, "PPT"}, Segment{true, "RD1"}, Segment{false, "V1"},
+                 Segment{true, "RD2"}, Segment{false, "V2"}}};
+    }
+}
+
+TEST(PptLoopbackSimulatorTest, ReplaysRecordedSession) {
+    DSSC::PptLoopbackSimulator sim;
+    sim.setSession(recordedPolling());
+    const unsigned int port = sim.start();
+    ASSERT_NE(port, 0u);
+
+    DSSC::PptLoopbackClient client;
+    ASSERT_TRUE(client.connect(port));
+
+    std::string reply;
+    ASSERT_TRUE(client.receive(3, reply));
+    EXPECT_EQ(reply, "PPT") << "The PPT talks first";
+
+    // sent in pieces, answered once complete
+    ASSERT_TRUE(client.send("R"));
+    std::this_thread::sleep_for(milliseconds(20));
+    ASSERT_TRUE(client.send("D1"));
+    ASSERT_TRUE(client.receive(2, reply));
+    EXPECT_EQ(reply, "V1");
+
+    // polled more often than recorded
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(client.send("RD2"));
+        ASSERT_TRUE(client.receive(2, reply));
+        EXPECT_EQ(reply, "V2");
+    }
+    ASSERT_TRUE(client.send("RD1"));
+    ASSERT_TRUE(client.receive(2, reply));
+    EXPECT_EQ(reply, "V1");
+
+    // never recorded, dropped
+    ASSERT_TRUE(client.send("XXX"));
+    std::this_thread::sleep_for(milliseconds(20));
+    ASSERT_TRUE(client.send("RD2"));
+    ASSERT_TRUE(client.receive(2, reply));
+    EXPECT_EQ(reply, "V2");
+    EXPECT_EQ(sim.numRequests(), 6u);
+    EXPECT_EQ(sim.numUnmatched(), 1u);
+    EXPECT_EQ(sim.numConnections(), 1u);
+}
+
+TEST(PptLoopbackSimulatorTest, RecordsThroughUpstream) {
+    DSSC::PptLoopbackSimulator ppt;
+    ppt.setSession(recordedPolling());
+    const unsigned int pptPort = ppt.start();
+    ASSERT_NE(pptPort, 0u);
+
+    DSSC::PptLoopbackSimulator recorder;
+    recorder.setUpstream("127.0.0.1", pptPort);
+    const unsigned int port = recorder.start();
+    ASSERT_NE(port, 0u);
+
+    {
+        DSSC::PptLoopbackClient client;
+        ASSERT_TRUE(client.connect(port));
+        std::string reply;
+        ASSERT_TRUE(client.receive(3, reply));
+        ASSERT_TRUE(client.send("RD1"));
+        ASSERT_TRUE(client.receive(2, reply));
+        ASSERT_TRUE(client.send("RD2"));
+        ASSERT_TRUE(client.receive(2, reply));
+    }
+    recorder.stop();
+    EXPECT_EQ(recorder.recordedSession(), recordedPolling());
+
+    const std::string fileName = "testPptLoopbackSimulator.capture";
+    ASSERT_TRUE(DSSC::PptLoopbackSimulator::saveCapture(fileName, recorder.recordedSession()));
+    DSSC::PptLoopbackSimulator::Session loaded;
+    ASSERT_TRUE(DSSC::PptLoopbackSimulator::loadCapture(fileName, loaded));
+    EXPECT_EQ(loaded, recordedPolling());
+    std::remove(fileName.c_str());
+}
+
+TEST(PptLoopbackSimulatorTest, ReapsFinishedClients) {
+    DSSC::PptLoopbackSimulator sim;
+    const unsigned int port = sim.start();
+    ASSERT_NE(port, 0u);
+
+    for (int i = 0; i < 3; ++i) {
+        DSSC::PptLoopbackClient client;
+        ASSERT_TRUE(client.connect(port));
+    }
+    const auto deadline = steady_clock::now() + seconds(2);
+    while ((sim.numConnections() < 3 || sim.numClients() > 0) && steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(milliseconds(10));
+    }
+    EXPECT_EQ(sim.numClients(), 0u);
+    EXPECT_EQ(sim.numConnections(), 3u);
+}
+
+TEST(PptLoopbackSimulatorTest, LatencyAndJitterAreApplied) {
+    DSSC::PptLoopbackSimulator sim;
+    sim.setSession(recordedPolling());
+    const unsigned int port = sim.start();
+    ASSERT_NE(port, 0u);
+    sim.setLatency(milliseconds(5), milliseconds(2));
+
+    DSSC::PptLoopbackClient client;
+    ASSERT_TRUE(client.connect(port));
+    std::string reply;
+    ASSERT_TRUE(client.receive(3, reply));
+
+    const int numRequests = 20;
+    auto start = steady_clock::now();
+    for (int i = 0; i < numRequests; ++i) {
+        ASSERT_TRUE(client.send("RD1"));
+        ASSERT_TRUE(client.receive(2, reply));
+    }
+    auto elapsed = duration_cast<milliseconds>(steady_clock::now() - start).count();
+    EXPECT_GE(elapsed, numRequests * 5);
+    EXPECT_LT(elapsed, numRequests * 7 + 500);
+}